@@ -0,0 +1,304 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// Internal headers
+#include "mpeghuitranslator/allocations.h"
+#include "mpeghuitranslator/mpeghuitranslator_c.h"
+#include "mpeghuitranslator/translator.h"
+#include "audio_scene_generator_helper.h"
+
+// External headers
+#include "json/json.h"
+
+// System headers
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mpeghuitranslator;
+
+/*!
+ * Maximum number of heap allocations of a single steady-state call, i.e. a call of a translator
+ * which already translated the same AudioScene before. For the "Changing" calls, the scene changes
+ * differ from the ones of the previous call.
+ */
+struct SAllocationBudget {
+  const char* version;
+  const char* call;
+  // Allocations via operator new
+  std::uint64_t maxAllocations;
+  // Allocations of libxml2
+  std::uint64_t maxXmlAllocations;
+};
+
+// clang-format off
+// Budgets for the generated default scene (4 presets, 8 audio elements per preset or on AudioScene
+// level for version 9.0, one switch group with 2 items, 2 label languages). The measured counts
+// are about 20% below the budgets to allow for differences between standard libraries.
+//
+// The C interface does not allocate at all for repeated inputs: it skips parsing the same
+// AudioScene XML and scene changes JSON again and reuses its JSON text and ActionEvent strings.
+// The output strings of the ActionEvents are allocated via malloc() for the caller and are not
+// counted.
+// The remaining allocations are the libxml2 document of the AudioScene XML and the AudioScene
+// structure which is parsed before it is found in the shared structures, the Json::Value results
+// of the C++ interface, the parsed scene changes JSON and the new ActionEvent strings of the C++
+// interface.
+static const SAllocationBudget BUDGETS[] = {
+  {"9.0",  "toJson",               580,  980},
+  {"9.0",  "toXml",                 18,    0},
+  {"9.0",  "cApiToJson",             0,    0},
+  {"9.0",  "cApiToXml",              0,    0},
+  {"9.0",  "cApiToXmlChanging",     90,    0},
+  {"10.0", "toJson",              1980, 3330},
+  {"10.0", "toXml",                 18,    0},
+  {"10.0", "cApiToJson",             0,    0},
+  {"10.0", "cApiToXml",              0,    0},
+  {"10.0", "cApiToXmlChanging",     90,    0},
+  {"11.0", "toJson",              1940, 3290},
+  {"11.0", "toXml",                 18,    0},
+  {"11.0", "cApiToJson",             0,    0},
+  {"11.0", "cApiToXml",              0,    0},
+  {"11.0", "cApiToXmlChanging",     90,    0},
+};
+// clang-format on
+
+// Number of measured calls per budget, the maximum of all calls is compared with the budget
+static const int NUM_CALLS = 8;
+
+/*!
+ * Builds scene changes moving the prominence of all audio elements of the active preset to the
+ * given bound, based on the JSON output of the translator.
+ */
+static Json::Value buildSceneChanges(const Json::Value& sceneJson, const char* bound) {
+  Json::Value changes{};
+  changes["uuid"] = sceneJson["uuid"];
+  for (const auto& preset : sceneJson["audioPresets"]) {
+    if (!preset["active"].asBool()) {
+      continue;
+    }
+    auto& changedPreset = changes["audioPresets"].append(Json::Value{});
+    changedPreset["id"] = preset["id"];
+    for (const auto& object : preset["objects"]) {
+      if (object.isMember("prominence")) {
+        auto& changedObject = changedPreset["objects"].append(Json::Value{});
+        changedObject["id"] = object["id"];
+        changedObject["prominence"]["level"] = object["prominence"][bound];
+      }
+    }
+  }
+  return changes;
+}
+
+static bool checkBudget(const SAllocationBudget& budget, const SAllocationReport& maxAllocations) {
+  std::cout << budget.version << " " << budget.call << ": " << maxAllocations.numAllocations << "/"
+            << budget.maxAllocations << " allocations, " << maxAllocations.numXmlAllocations << "/"
+            << budget.maxXmlAllocations << " libxml2 allocations" << std::endl;
+  return maxAllocations.numAllocations <= budget.maxAllocations &&
+         maxAllocations.numXmlAllocations <= budget.maxXmlAllocations;
+}
+
+static void updateMaximum(SAllocationReport& maxAllocations) {
+  const auto allocations = getLastCallAllocations();
+  maxAllocations.numAllocations =
+      std::max(maxAllocations.numAllocations, allocations.numAllocations);
+  maxAllocations.numXmlAllocations =
+      std::max(maxAllocations.numXmlAllocations, allocations.numXmlAllocations);
+}
+
+static const SAllocationBudget& findBudget(const std::string& version, const std::string& call) {
+  for (const auto& budget : BUDGETS) {
+    if (version == budget.version && call == budget.call) {
+      return budget;
+    }
+  }
+  throw std::logic_error{"No allocation budget for " + version + " " + call};
+}
+
+/*!
+ * Measures the steady-state calls of the C++ interface for the given AudioScene XML.
+ */
+static bool checkTranslator(const std::string& version, const std::string& xml) {
+  CUiTranslator translator{"eng"};
+  // warm-up, the first call parses the AudioScene structure
+  const auto sceneJson = translator.mpeghInteractivityToJson(xml);
+  const Json::Value changes[] = {buildSceneChanges(sceneJson, "max"),
+                                 buildSceneChanges(sceneJson, "min")};
+  translator.mpeghInteractivityToXml(changes[0]);
+
+  SAllocationReport maxToJson{};
+  SAllocationReport maxToXml{};
+  for (int i = 0; i < NUM_CALLS; ++i) {
+    translator.mpeghInteractivityToJson(xml);
+    updateMaximum(maxToJson);
+    translator.mpeghInteractivityToXml(changes[i % 2]);
+    updateMaximum(maxToXml);
+  }
+
+  const bool isToJsonOk = checkBudget(findBudget(version, "toJson"), maxToJson);
+  const bool isToXmlOk = checkBudget(findBudget(version, "toXml"), maxToXml);
+  return isToJsonOk && isToXmlOk;
+}
+
+/*!
+ * Measures the steady-state calls of the C interface for the given AudioScene XML, i.e. with an
+ * output buffer which is large enough.
+ */
+static bool checkHandle(const std::string& version, const std::string& xml) {
+  auto handle = mpeghUiTranslatorCreate("eng");
+  std::vector<char> jsonBuffer(1);
+  auto toJson = [&]() {
+    auto jsonSize = jsonBuffer.size();
+    if (mpeghUiTranslatorHandleToJson(handle, xml.data(), xml.size(), jsonBuffer.data(),
+                                      &jsonSize) == MPEGHUITRANSLATOR_INSUFFICIENT_SPACE) {
+      jsonBuffer.resize(jsonSize);
+      mpeghUiTranslatorHandleToJson(handle, xml.data(), xml.size(), jsonBuffer.data(), &jsonSize);
+    }
+    return std::string(jsonBuffer.data(), jsonSize);
+  };
+  auto toXml = [&](const std::string& changes) {
+    MpeghUiTranslatorStringList events{};
+    mpeghUiTranslatorHandleToXml(handle, changes.data(), changes.size(), &events);
+    mpeghUiTranslatorFreeStrings(&events);
+  };
+
+  // warm-up, the first calls parse the AudioScene structure and grow the buffers
+  Json::Value sceneJson{};
+  Json::Reader{}.parse(toJson(), sceneJson);
+  Json::StreamWriterBuilder builder{};
+  builder["indentation"] = "";
+  const std::string changes[] = {Json::writeString(builder, buildSceneChanges(sceneJson, "max")),
+                                 Json::writeString(builder, buildSceneChanges(sceneJson, "min"))};
+  toXml(changes[0]);
+
+  toXml(changes[1]);
+
+  SAllocationReport maxToJson{};
+  SAllocationReport maxToXml{};
+  SAllocationReport maxToXmlChanging{};
+  for (int i = 0; i < NUM_CALLS; ++i) {
+    toJson();
+    updateMaximum(maxToJson);
+    toXml(changes[i % 2]);
+    updateMaximum(maxToXmlChanging);
+    toXml(changes[i % 2]);
+    updateMaximum(maxToXml);
+  }
+  mpeghUiTranslatorDestroy(handle);
+
+  const bool isToJsonOk = checkBudget(findBudget(version, "cApiToJson"), maxToJson);
+  const bool isToXmlOk = checkBudget(findBudget(version, "cApiToXml"), maxToXml);
+  const bool isToXmlChangingOk =
+      checkBudget(findBudget(version, "cApiToXmlChanging"), maxToXmlChanging);
+  return isToJsonOk && isToXmlOk && isToXmlChangingOk;
+}
+
+static bool checkVersion(const std::string& version) {
+  SAudioSceneGeneratorConfig config{};
+  config.version = version;
+  const auto xml = generateAudioScene(config);
+
+  const bool isTranslatorOk = checkTranslator(version, xml);
+  const bool isHandleOk = checkHandle(version, xml);
+  return isTranslatorOk && isHandleOk;
+}
+
+int main() {
+  if (!getLastCallAllocations().isEnabled) {
+    std::cerr << "The library was built without allocation accounting" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  bool isOk = true;
+  for (const auto* version : {"9.0", "10.0", "11.0"}) {
+    isOk = checkVersion(version) && isOk;
+  }
+  if (!isOk) {
+    std::cerr << "Allocation budget exceeded" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
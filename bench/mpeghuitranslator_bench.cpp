@@ -0,0 +1,300 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// Internal headers
+#include "mpeghuitranslator/allocations.h"
+#include "mpeghuitranslator/mpeghuitranslator_c.h"
+#include "allocation_accounting.h"
+#include "audio_scene.h"
+#include "scene_changes.h"
+#include "xml_helper.h"
+#include "audio_scene_generator_helper.h"
+
+// External headers
+#include "json/json.h"
+
+// System headers
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace mpeghuitranslator;
+
+/*!
+ * Dimensions of a synthetic AudioScene.
+ */
+struct SSceneSize {
+  std::string version;
+  std::size_t numPresets;
+  // Number of audio elements per preset (version >= 10.0) or on AudioScene level (version 9.0)
+  std::size_t numElements;
+  // Number of languages of each label
+  std::size_t numLanguages;
+};
+
+static SAudioSceneGeneratorConfig makeGeneratorConfig(const SSceneSize& size) {
+  SAudioSceneGeneratorConfig config{};
+  config.version = size.version;
+  config.numPresets = size.numPresets;
+  config.numElements = size.numElements;
+  config.numLanguages = size.numLanguages;
+  // every element needs a prominence property for the scene changes
+  config.prominenceRatio = 1.0;
+  return config;
+}
+
+/*!
+ * Builds scene changes moving the prominence of all audio elements of the active (first) preset to
+ * its maximum.
+ */
+static Json::Value buildSceneChanges(const SAudioSceneConfig& asi) {
+  Json::Value changes{};
+  changes["uuid"] = asi.uuid;
+  auto& preset = changes["audioPresets"].append(Json::Value{});
+  preset["id"] = 0;
+  auto& objects = preset["objects"];
+
+  // version 9.0 has the audio elements of the active preset on AudioScene level
+  const auto& elements = asi.audioElements.empty() ? asi.presets.front().audioElements
+                                                   : asi.audioElements;
+  for (const auto& element : elements) {
+    auto& object = objects.append(Json::Value{});
+    object["id"] = element.id;
+    object["prominence"]["level"] = element.prominence->maxValue;
+  }
+  return changes;
+}
+
+struct SOptions {
+  double minSeconds = 0.2;
+  std::string filter;
+  bool isFullMatrix = false;
+};
+
+/*!
+ * Runs the given function repeatedly for at least the configured time and prints the result as a
+ * single JSON line.
+ */
+static void runBenchmark(const SOptions& options, const std::string& name, const SSceneSize& size,
+                         std::size_t numBytes, const std::function<void()>& func) {
+  if (name.find(options.filter) == std::string::npos) {
+    return;
+  }
+
+  using SClock = std::chrono::steady_clock;
+  func();  // warm-up
+
+  std::size_t numIterations = 0;
+  const auto startTime = SClock::now();
+  std::chrono::duration<double> elapsed{};
+  do {
+    func();
+    ++numIterations;
+    elapsed = SClock::now() - startTime;
+  } while (elapsed.count() < options.minSeconds);
+
+  {
+    // one more (untimed) run to count its allocations, if enabled
+    CAllocationScope allocationScope{};
+    func();
+  }
+  const auto allocations = getLastCallAllocations();
+
+  Json::Value result{};
+  result["benchmark"] = name;
+  result["version"] = size.version;
+  result["presets"] = static_cast<Json::UInt64>(size.numPresets);
+  result["elements"] = static_cast<Json::UInt64>(size.numElements);
+  result["languages"] = static_cast<Json::UInt64>(size.numLanguages);
+  result["inputBytes"] = static_cast<Json::UInt64>(numBytes);
+  result["iterations"] = static_cast<Json::UInt64>(numIterations);
+  result["nsPerOp"] = elapsed.count() * 1e9 / static_cast<double>(numIterations);
+  if (allocations.isEnabled) {
+    result["allocsPerOp"] = static_cast<Json::UInt64>(allocations.numAllocations);
+    result["allocBytesPerOp"] = static_cast<Json::UInt64>(allocations.numBytes);
+    result["xmlAllocsPerOp"] = static_cast<Json::UInt64>(allocations.numXmlAllocations);
+    result["xmlAllocBytesPerOp"] = static_cast<Json::UInt64>(allocations.numXmlBytes);
+  }
+
+  Json::StreamWriterBuilder builder{};
+  builder["indentation"] = "";
+  std::cout << Json::writeString(builder, result) << std::endl;
+}
+
+static void runSceneBenchmarks(const SOptions& options, const SSceneSize& size) {
+  const auto xml = generateAudioScene(makeGeneratorConfig(size));
+  SXmlString document{xml};
+  SAudioScene scene{};
+  scene.config = std::make_shared<const SAudioSceneConfig>(
+      parseAudioScene(document.getRoot(), scene.values));
+  scene.activePresetId = findActivePresetId(*scene.config, scene.values);
+  const auto& asi = *scene.config;
+
+  const auto changesJson = buildSceneChanges(asi);
+  Json::StreamWriterBuilder builder{};
+  const auto changesString = Json::writeString(builder, changesJson);
+
+  const auto changes = parseAudioSceneChanges(changesJson);
+  const std::string displayLanguage{"eng"};
+
+  runBenchmark(options, "parseAudioScene", size, xml.size(), [&xml]() {
+    SXmlString doc{xml};
+    SAudioSceneValues values{};
+    std::ignore = parseAudioScene(doc.getRoot(), values);
+  });
+  runBenchmark(options, "composeAudioScene", size, xml.size(),
+               [&]() { std::ignore = composeAudioScene(asi, scene.values, displayLanguage); });
+  runBenchmark(options, "parseAudioSceneChanges", size, changesString.size(),
+               [&]() { std::ignore = parseAudioSceneChanges(changesJson); });
+  runBenchmark(options, "composeActionEvents", size, changesString.size(),
+               [&]() { std::ignore = composeActionEvents(changes, &scene, &displayLanguage); });
+
+  auto handle = mpeghUiTranslatorCreate("eng");
+  std::vector<char> jsonBuffer(xml.size() * 4 + 4096);
+  runBenchmark(options, "cApiToJson", size, xml.size(), [&]() {
+    auto jsonSize = jsonBuffer.size();
+    if (mpeghUiTranslatorHandleToJson(handle, xml.data(), xml.size(), jsonBuffer.data(),
+                                      &jsonSize) == MPEGHUITRANSLATOR_INSUFFICIENT_SPACE) {
+      jsonBuffer.resize(jsonSize);
+      mpeghUiTranslatorHandleToJson(handle, xml.data(), xml.size(), jsonBuffer.data(), &jsonSize);
+    }
+  });
+  runBenchmark(options, "cApiToXml", size, changesString.size(), [&]() {
+    MpeghUiTranslatorStringList events{};
+    mpeghUiTranslatorHandleToXml(handle, changesString.data(), changesString.size(), &events);
+    mpeghUiTranslatorFreeStrings(&events);
+  });
+  mpeghUiTranslatorDestroy(handle);
+}
+
+int main(int argc, char** argv) {
+  SOptions options{};
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+      options.minSeconds = std::strtod(argv[++i], nullptr);
+    } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+      options.filter = argv[++i];
+    } else if (std::strcmp(argv[i], "--full") == 0) {
+      options.isFullMatrix = true;
+    } else {
+      std::cout << "Usage: <program> [--min-time <seconds>] [--filter <benchmark name>] [--full]"
+                << std::endl
+                << "Prints one JSON object per benchmark and scene size." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const std::vector<std::size_t> presetCounts{1, 4, 16, 64, 256};
+  const std::vector<std::size_t> elementCounts{1, 8, 32, 128};
+  const std::vector<std::size_t> languageCounts{1, 5, 20};
+
+  for (const auto* version : {"9.0", "10.0", "11.0"}) {
+    if (options.isFullMatrix) {
+      for (auto numPresets : presetCounts) {
+        for (auto numElements : elementCounts) {
+          for (auto numLanguages : languageCounts) {
+            runSceneBenchmarks(options, SSceneSize{version, numPresets, numElements, numLanguages});
+          }
+        }
+      }
+      continue;
+    }
+
+    // Scale a single dimension at a time around a typical scene
+    for (auto numPresets : presetCounts) {
+      runSceneBenchmarks(options, SSceneSize{version, numPresets, 8, 2});
+    }
+    for (auto numElements : elementCounts) {
+      runSceneBenchmarks(options, SSceneSize{version, 4, numElements, 2});
+    }
+    for (auto numLanguages : languageCounts) {
+      runSceneBenchmarks(options, SSceneSize{version, 4, 8, numLanguages});
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
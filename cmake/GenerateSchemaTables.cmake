@@ -0,0 +1,198 @@
+# Generates the C++ tables of a set of JSON Schema files for the in-library validation, see
+# src/schema_tables.h. Only the JSON Schema keywords used in the json_schema/ project folder are
+# supported: $id, $ref, type, format, properties, required, items, minimum, maximum, minLength,
+# maxLength, minItems and maxItems.
+#
+# Usage (at build time):
+#   cmake -DSCHEMA_DIR=<folder> -DROOT_SCHEMA_ID=<$id> -DTABLE_NAME=<C++ name> -DOUTPUT=<file>
+#         -P GenerateSchemaTables.cmake
+cmake_minimum_required(VERSION 3.19)
+
+foreach(parameter SCHEMA_DIR ROOT_SCHEMA_ID TABLE_NAME OUTPUT)
+  if(NOT DEFINED ${parameter})
+    message(FATAL_ERROR "Missing parameter ${parameter}")
+  endif()
+endforeach()
+
+# Returns the value of the given member of a JSON object or an empty string if it does not exist
+function(json_get_optional outVar json member)
+  string(JSON value ERROR_VARIABLE error GET "${json}" "${member}")
+  if(error)
+    set(value "")
+  endif()
+  set(${outVar} "${value}" PARENT_SCOPE)
+endfunction()
+
+function(schema_index_variable outVar id)
+  string(MAKE_C_IDENTIFIER "${id}" identifier)
+  set(${outVar} "SCHEMA_INDEX_${identifier}" PARENT_SCOPE)
+endfunction()
+
+# Appends a new, still empty node and returns its index
+function(allocate_node outIndex)
+  get_property(numNodes GLOBAL PROPERTY SCHEMA_NUM_NODES)
+  math(EXPR next "${numNodes} + 1")
+  set_property(GLOBAL PROPERTY SCHEMA_NUM_NODES ${next})
+  set(${outIndex} ${numNodes} PARENT_SCOPE)
+endfunction()
+
+function(append_bound outVar json member)
+  json_get_optional(value "${json}" "${member}")
+  if(value STREQUAL "")
+    set(${outVar} "${${outVar}}, false, 0" PARENT_SCOPE)
+  else()
+    set(${outVar} "${${outVar}}, true, ${value}" PARENT_SCOPE)
+  endif()
+endfunction()
+
+# Compiles the given JSON value description into the node with the given index
+function(compile_node index json name)
+  json_get_optional(type "${json}" "type")
+  json_get_optional(format "${json}" "format")
+  set(first 0)
+  set(count 0)
+  set(minimumMember "minimum")
+  set(maximumMember "maximum")
+
+  if(type STREQUAL "object")
+    set(kind kObject)
+    json_get_optional(properties "${json}" "properties")
+    json_get_optional(required "${json}" "required")
+    set(memberLines "")
+    if(NOT properties STREQUAL "")
+      string(JSON count LENGTH "${properties}")
+    endif()
+    if(count GREATER 0)
+      math(EXPR last "${count} - 1")
+      foreach(i RANGE ${last})
+        string(JSON memberName MEMBER "${properties}" ${i})
+        string(JSON memberJson GET "${properties}" "${memberName}")
+        resolve_node(memberIndex "${memberJson}" "${memberName}")
+        set(isRequired false)
+        if(NOT required STREQUAL "" AND required MATCHES "\"${memberName}\"")
+          set(isRequired true)
+        endif()
+        list(APPEND memberLines "    {\"${memberName}\", ${memberIndex}, ${isRequired}},")
+      endforeach()
+    endif()
+    # Append the members after all nested nodes were compiled to keep them contiguous
+    get_property(members GLOBAL PROPERTY SCHEMA_MEMBER_LINES)
+    list(LENGTH members first)
+    set_property(GLOBAL APPEND PROPERTY SCHEMA_MEMBER_LINES ${memberLines})
+  elseif(type STREQUAL "array")
+    set(kind kArray)
+    json_get_optional(items "${json}" "items")
+    if(items STREQUAL "")
+      message(FATAL_ERROR "Array '${name}' without 'items' is not supported")
+    endif()
+    resolve_node(first "${items}" "${name}[]")
+    set(minimumMember "minItems")
+    set(maximumMember "maxItems")
+  elseif(type STREQUAL "integer")
+    set(kind kInteger)
+  elseif(type STREQUAL "number")
+    set(kind kNumber)
+  elseif(type STREQUAL "boolean")
+    set(kind kBoolean)
+  elseif(type STREQUAL "string" AND format STREQUAL "uuid")
+    set(kind kUuid)
+  elseif(type STREQUAL "string")
+    set(kind kString)
+    set(minimumMember "minLength")
+    set(maximumMember "maxLength")
+  else()
+    message(FATAL_ERROR "Unsupported type '${type}' of '${name}'")
+  endif()
+
+  set(line "    {ESchemaNodeKind::${kind}, \"${name}\", ${first}, ${count}")
+  append_bound(line "${json}" "${minimumMember}")
+  append_bound(line "${json}" "${maximumMember}")
+  set_property(GLOBAL PROPERTY SCHEMA_NODE_LINE_${index} "${line}},")
+endfunction()
+
+# Returns the node index of a referenced schema ($ref) or compiles a new node for the given inline
+# value description
+function(resolve_node outIndex json name)
+  json_get_optional(ref "${json}" "$ref")
+  if(NOT ref STREQUAL "")
+    schema_index_variable(variable "${ref}")
+    get_property(index GLOBAL PROPERTY ${variable})
+    if(index STREQUAL "")
+      message(FATAL_ERROR "Unknown schema reference '${ref}' of '${name}'")
+    endif()
+  else()
+    allocate_node(index)
+    compile_node(${index} "${json}" "${name}")
+  endif()
+  set(${outIndex} ${index} PARENT_SCOPE)
+endfunction()
+
+file(GLOB schemaFiles "${SCHEMA_DIR}/*.schema.json")
+list(SORT schemaFiles)
+set_property(GLOBAL PROPERTY SCHEMA_NUM_NODES 0)
+set_property(GLOBAL PROPERTY SCHEMA_MEMBER_LINES "")
+
+# The first nodes are the schemas in file order, so that references can be resolved up front
+set(schemaIds "")
+foreach(file IN LISTS schemaFiles)
+  file(READ "${file}" json)
+  string(JSON id GET "${json}" "$id")
+  allocate_node(index)
+  schema_index_variable(variable "${id}")
+  set_property(GLOBAL PROPERTY ${variable} ${index})
+  list(APPEND schemaIds "${id}")
+endforeach()
+
+foreach(file IN LISTS schemaFiles)
+  file(READ "${file}" json)
+  string(JSON id GET "${json}" "$id")
+  schema_index_variable(variable "${id}")
+  get_property(index GLOBAL PROPERTY ${variable})
+  compile_node(${index} "${json}" "${id}")
+endforeach()
+
+schema_index_variable(variable "${ROOT_SCHEMA_ID}")
+get_property(rootIndex GLOBAL PROPERTY ${variable})
+if(rootIndex STREQUAL "")
+  message(FATAL_ERROR "Unknown root schema '${ROOT_SCHEMA_ID}'")
+endif()
+
+get_property(numNodes GLOBAL PROPERTY SCHEMA_NUM_NODES)
+math(EXPR lastNode "${numNodes} - 1")
+set(nodeLines "")
+foreach(i RANGE ${lastNode})
+  get_property(line GLOBAL PROPERTY SCHEMA_NODE_LINE_${i})
+  string(APPEND nodeLines "${line}\n")
+endforeach()
+get_property(memberLines GLOBAL PROPERTY SCHEMA_MEMBER_LINES)
+list(JOIN memberLines "\n" memberLines)
+
+get_filename_component(schemaFolder "${SCHEMA_DIR}" NAME)
+set(content "// Generated by cmake/GenerateSchemaTables.cmake from the ${schemaFolder} JSON Schemas, do not edit!
+
+#include \"schema_tables.h\"
+
+namespace mpeghuitranslator {
+
+static const SSchemaNode NODES[] = {
+${nodeLines}};
+
+static const SSchemaMember MEMBERS[] = {
+${memberLines}
+    // end marker, so that the table is never empty
+    {nullptr, 0, false},
+};
+
+const SSchemaTable ${TABLE_NAME} = {NODES, MEMBERS, ${rootIndex}};
+
+}  // namespace mpeghuitranslator
+")
+
+# Only touch the output if it changed to avoid needless recompilation
+if(EXISTS "${OUTPUT}")
+  file(READ "${OUTPUT}" oldContent)
+  if(oldContent STREQUAL content)
+    return()
+  endif()
+endif()
+file(WRITE "${OUTPUT}" "${content}")
@@ -0,0 +1,159 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#include "audio_scene_generator_helper.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+static void printUsage() {
+  std::cout << "Usage: <program> [options]" << std::endl
+            << "Writes a deterministic, valid AudioScene XML document to stdout." << std::endl
+            << "  --seed <number>          Seed of the generator (default 0)" << std::endl
+            << "  --version 9.0|10.0|11.0  AudioScene XML format version (default 10.0)"
+            << std::endl
+            << "  --presets <count>        Number of presets (default 4)" << std::endl
+            << "  --elements <count>       Number of audio elements per preset (default 8)"
+            << std::endl
+            << "  --switch-groups <count>  Number of switch groups per preset (default 1)"
+            << std::endl
+            << "  --items <count>          Number of items per switch group (default 2)"
+            << std::endl
+            << "  --languages <count>      Number of languages per label (default 2)" << std::endl
+            << "  --prominence <ratio>     Probability of prominence properties (default 1.0)"
+            << std::endl
+            << "  --muting <ratio>         Probability of muting properties (default 1.0)"
+            << std::endl
+            << "  --azimuth <ratio>        Probability of azimuth properties (default 0.5)"
+            << std::endl
+            << "  --elevation <ratio>      Probability of elevation properties (default 0.5)"
+            << std::endl;
+}
+
+int main(int argc, char** argv) {
+  SAudioSceneGeneratorConfig config{};
+  for (int i = 1; i < argc; ++i) {
+    const std::string option{argv[i]};
+    if (i + 1 >= argc) {
+      printUsage();
+      return EXIT_FAILURE;
+    }
+    const char* value = argv[++i];
+
+    if (option == "--seed") {
+      config.seed = std::strtoull(value, nullptr, 10);
+    } else if (option == "--version") {
+      config.version = value;
+    } else if (option == "--presets") {
+      config.numPresets = std::strtoul(value, nullptr, 10);
+    } else if (option == "--elements") {
+      config.numElements = std::strtoul(value, nullptr, 10);
+    } else if (option == "--switch-groups") {
+      config.numSwitchGroups = std::strtoul(value, nullptr, 10);
+    } else if (option == "--items") {
+      config.numSwitchGroupItems = std::strtoul(value, nullptr, 10);
+    } else if (option == "--languages") {
+      config.numLanguages = std::strtoul(value, nullptr, 10);
+    } else if (option == "--prominence") {
+      config.prominenceRatio = std::strtod(value, nullptr);
+    } else if (option == "--muting") {
+      config.mutingRatio = std::strtod(value, nullptr);
+    } else if (option == "--azimuth") {
+      config.azimuthRatio = std::strtod(value, nullptr);
+    } else if (option == "--elevation") {
+      config.elevationRatio = std::strtod(value, nullptr);
+    } else {
+      printUsage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  try {
+    std::cout << generateAudioScene(config);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
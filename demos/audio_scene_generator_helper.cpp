@@ -0,0 +1,251 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#include "audio_scene_generator_helper.h"
+
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+
+static const char* const LANGUAGES[] = {"eng", "deu", "fra", "spa", "ita", "por", "nld",
+                                        "pol", "ces", "swe", "dan", "fin", "nor", "hun",
+                                        "ell", "tur", "rus", "jpn", "kor", "zho"};
+static const std::size_t NUM_LANGUAGES = sizeof(LANGUAGES) / sizeof(LANGUAGES[0]);
+
+static const char* const WORDS[] = {"Dialog", "Commentary", "Ambience", "Music", "Effects",
+                                    "Stadium", "Home",     "Away",     "Audio", "Description"};
+static const std::size_t NUM_WORDS = sizeof(WORDS) / sizeof(WORDS[0]);
+
+namespace {
+
+/*!
+ * Writes the XML document while drawing all random decisions from a single generator, so the
+ * output only depends on the configuration.
+ */
+class CAudioSceneWriter {
+ public:
+  explicit CAudioSceneWriter(const SAudioSceneGeneratorConfig& config)
+      : m_config(config), m_rng(config.seed) {}
+
+  std::string write() {
+    const bool isVersion9 = m_config.version == "9.0";
+
+    m_out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+          << "<AudioSceneConfig uuid=\"" << generateUuid() << "\" version=\"" << m_config.version
+          << "\" configChange=\"false\">\n"
+          << "  <DRCInfo><drcSetEffectAvailable index=\"" << m_rng.nextInRange(1, 6)
+          << "\"/></DRCInfo>\n"
+          << "  <presets>\n";
+    for (std::size_t preset = 0; preset < m_config.numPresets; ++preset) {
+      writePreset(preset, !isVersion9);
+    }
+    m_out << "  </presets>\n";
+
+    if (isVersion9) {
+      writeElementsAndSwitchGroups("  ");
+    }
+    m_out << "</AudioSceneConfig>\n";
+    return m_out.str();
+  }
+
+ private:
+  std::string generateUuid() {
+    const auto high = m_rng.next();
+    const auto low = m_rng.next();
+    char uuid[37];
+    std::snprintf(uuid, sizeof(uuid), "%08x-%04x-%04x-%04x-%012llx",
+                  static_cast<unsigned>(high >> 32), static_cast<unsigned>((high >> 16) & 0xFFFF),
+                  static_cast<unsigned>(high & 0xFFFF), static_cast<unsigned>(low >> 48),
+                  static_cast<unsigned long long>(low & 0xFFFFFFFFFFFFULL));
+    return uuid;
+  }
+
+  void writeLabels(const char* indent, const char* langCodeAttribute) {
+    m_out << indent << "<customKind" << langCodeAttribute << ">";
+    const auto word = WORDS[m_rng.nextIndex(NUM_WORDS)];
+    for (std::size_t i = 0; i < m_config.numLanguages; ++i) {
+      m_out << "<description langCode=\"" << LANGUAGES[i % NUM_LANGUAGES] << "\">" << word << ' '
+            << i << "</description>";
+    }
+    m_out << "</customKind>\n";
+  }
+
+  void writeRangeProperty(const char* indent, const char* name, std::int64_t limit) {
+    const auto minValue = -m_rng.nextInRange(0, limit);
+    const auto maxValue = m_rng.nextInRange(0, limit);
+    const auto defaultValue = m_rng.nextInRange(minValue, maxValue);
+    m_out << indent << "<" << name << " isActionAllowed=\"" << boolString(m_rng.nextBool(0.9))
+          << "\" min=\"" << minValue << "\" max=\"" << maxValue << "\" val=\""
+          << m_rng.nextInRange(minValue, maxValue) << "\" def=\"" << defaultValue << "\"/>\n";
+  }
+
+  void writeProperties(const char* indent, bool hasDirection) {
+    if (m_rng.nextBool(m_config.prominenceRatio)) {
+      writeRangeProperty(indent, "prominenceLevelProp", 12);
+    }
+    if (m_rng.nextBool(m_config.mutingRatio)) {
+      const auto isMuted = m_rng.nextBool(0.2);
+      m_out << indent << "<mutingProp isActionAllowed=\"" << boolString(m_rng.nextBool(0.9))
+            << "\" val=\"" << boolString(isMuted) << "\" def=\"" << boolString(isMuted) << "\"/>\n";
+    }
+    if (hasDirection && m_rng.nextBool(m_config.azimuthRatio)) {
+      writeRangeProperty(indent, "azimuthProp", 180);
+    }
+    if (hasDirection && m_rng.nextBool(m_config.elevationRatio)) {
+      writeRangeProperty(indent, "elevationProp", 90);
+    }
+  }
+
+  void writeAudioElement(const char* indent, std::size_t id) {
+    const std::string childIndent = std::string{indent} + "  ";
+    m_out << indent << "<audioElement id=\"" << id << "\" isAvailable=\"true\">\n";
+    writeProperties(childIndent.c_str(), true);
+    m_out << childIndent << "<kind code=\"" << m_rng.nextInRange(0, 15)
+          << "\" table=\"ContentKindTable\" langCode=\""
+          << LANGUAGES[m_rng.nextIndex(NUM_LANGUAGES)] << "\"/>\n";
+    writeLabels(childIndent.c_str(), " langCode=\"eng\"");
+    m_out << indent << "</audioElement>\n";
+  }
+
+  void writeSwitchGroup(const char* indent, std::size_t index) {
+    const std::string childIndent = std::string{indent} + "  ";
+    const auto activeItem = m_rng.nextIndex(m_config.numSwitchGroupItems);
+
+    m_out << indent << "<audioElementSwitch id=\"" << index
+          << "\" isAvailable=\"true\" isActionAllowed=\"" << boolString(m_rng.nextBool(0.9))
+          << "\">\n";
+    writeProperties(childIndent.c_str(), false);
+    m_out << childIndent << "<audioElements>\n";
+    for (std::size_t item = 0; item < m_config.numSwitchGroupItems; ++item) {
+      // switch group items are audio elements which are not part of the preset directly
+      const auto id = m_config.numElements + 1 + index * m_config.numSwitchGroupItems + item;
+      m_out << childIndent << "  <audioElement id=\"" << id << "\" isAvailable=\"true\" isActive=\""
+            << boolString(item == activeItem) << "\" isDefault=\"" << boolString(item == activeItem)
+            << "\"";
+      if (m_config.version == "11.0") {
+        m_out << " isSelectable=\"" << boolString(m_rng.nextBool(0.9)) << "\"";
+      }
+      m_out << "/>\n";
+    }
+    m_out << childIndent << "</audioElements>\n";
+    writeLabels(childIndent.c_str(), "");
+    m_out << indent << "</audioElementSwitch>\n";
+  }
+
+  void writeElementsAndSwitchGroups(const char* indent) {
+    for (std::size_t element = 1; element <= m_config.numElements; ++element) {
+      writeAudioElement(indent, element);
+    }
+    if (m_config.numSwitchGroupItems > 0) {
+      for (std::size_t group = 0; group < m_config.numSwitchGroups; ++group) {
+        writeSwitchGroup(indent, group);
+      }
+    }
+  }
+
+  void writePreset(std::size_t id, bool hasElements) {
+    const bool isFirst = id == 0;
+    m_out << "    <preset id=\"" << id << "\" isActive=\"" << boolString(isFirst)
+          << "\" isAvailable=\"true\" isDefault=\"" << boolString(isFirst) << "\">\n"
+          << "      <kind code=\"" << m_rng.nextInRange(1, 31) << "\" table=\"PresetTable\"/>\n";
+    writeLabels("      ", "");
+    if (hasElements) {
+      writeElementsAndSwitchGroups("      ");
+    }
+    m_out << "    </preset>\n";
+  }
+
+  static const char* boolString(bool value) { return value ? "true" : "false"; }
+
+  const SAudioSceneGeneratorConfig& m_config;
+  CSplitMix64 m_rng;
+  std::ostringstream m_out;
+};
+
+}  // namespace
+
+std::string generateAudioScene(const SAudioSceneGeneratorConfig& config) {
+  if (config.version != "9.0" && config.version != "10.0" && config.version != "11.0") {
+    throw std::invalid_argument{"Unsupported AudioScene version: " + config.version};
+  }
+  return CAudioSceneWriter{config}.write();
+}
@@ -0,0 +1,156 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*!
+ * Small, fast and deterministic pseudo random number generator (SplitMix64), which produces the
+ * same sequence for the same seed on all platforms, unlike the std::*_distribution types.
+ */
+class CSplitMix64 {
+ public:
+  explicit CSplitMix64(std::uint64_t seed) noexcept : m_state(seed) {}
+
+  std::uint64_t next() noexcept {
+    auto z = (m_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  /*! Returns a uniformly distributed value in [0, 1). */
+  double nextDouble() noexcept {
+    return static_cast<double>(next() >> 11) / static_cast<double>(1ULL << 53);
+  }
+
+  /*! Returns a uniformly distributed integer in [minValue, maxValue]. */
+  std::int64_t nextInRange(std::int64_t minValue, std::int64_t maxValue) noexcept {
+    const auto range = static_cast<std::uint64_t>(maxValue - minValue) + 1;
+    return minValue + static_cast<std::int64_t>(range == 0 ? next() : next() % range);
+  }
+
+  /*! Returns a uniformly distributed index in [0, size). */
+  std::size_t nextIndex(std::size_t size) noexcept {
+    return static_cast<std::size_t>(next() % static_cast<std::uint64_t>(size));
+  }
+
+  /*! Returns true with the given probability. */
+  bool nextBool(double probability = 0.5) noexcept { return nextDouble() < probability; }
+
+ private:
+  std::uint64_t m_state;
+};
+
+/*!
+ * Knobs of the synthetic AudioScene XML generator.
+ *
+ * NOTE: Counts beyond the ranges of the MPEG-H bitstream (e.g. more than 32 presets) produce XML
+ * which is accepted by the translator, but whose JSON output does not conform to the JSON Schemas.
+ */
+struct SAudioSceneGeneratorConfig {
+  std::uint64_t seed = 0;
+  // AudioScene XML format version, one of "9.0", "10.0" and "11.0"
+  std::string version = "10.0";
+  std::size_t numPresets = 4;
+  // Number of audio elements per preset (version >= 10.0) or on AudioScene level (version 9.0)
+  std::size_t numElements = 8;
+  // Number of switch groups per preset (version >= 10.0) or on AudioScene level (version 9.0)
+  std::size_t numSwitchGroups = 1;
+  std::size_t numSwitchGroupItems = 2;
+  // Number of languages of each label
+  std::size_t numLanguages = 2;
+  // Probabilities of each interactivity property to be present on an audio element / switch group
+  double prominenceRatio = 1.0;
+  double mutingRatio = 1.0;
+  double azimuthRatio = 0.5;
+  double elevationRatio = 0.5;
+};
+
+/*!
+ * Generates a valid AudioScene XML document with the given configuration. The same configuration
+ * always results in the same document. The first preset is the active and default one.
+ */
+std::string generateAudioScene(const SAudioSceneGeneratorConfig& config);
@@ -0,0 +1,378 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#include "audio_scene_generator_helper.h"
+
+#include "mpeghuitranslator/translator.h"
+
+#include "json/json.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*!
+ * Kinds of scene changes the generator can emit, in the order of the weights in SOptions.
+ */
+enum EChangeKind {
+  PRESET,
+  PROMINENCE,
+  MUTING,
+  AZIMUTH,
+  ELEVATION,
+  SWITCH_GROUP_ITEM,
+  SWITCH_GROUP_MUTING,
+  NUM_CHANGE_KINDS
+};
+
+static const char* const CHANGE_KIND_NAMES[NUM_CHANGE_KINDS] = {
+    "preset", "prominence", "muting", "azimuth", "elevation", "switch", "switch-muting"};
+
+/*!
+ * Single entity of the AudioScene which can be changed, with the valid range of its value.
+ */
+struct SChangeTarget {
+  int presetId;
+  int id;
+  double minValue;
+  double maxValue;
+  // Selectable items of a switch group
+  std::vector<int> itemIds;
+};
+
+struct SOptions {
+  std::uint64_t seed = 0;
+  std::size_t numDocuments = 100;
+  std::size_t minBatchSize = 1;
+  std::size_t maxBatchSize = 1;
+  bool isNulDelimited = false;
+  double weights[NUM_CHANGE_KINDS] = {1, 4, 2, 1, 1, 2, 1};
+};
+
+static std::string readFile(const char* fileName) {
+  std::ifstream fis{fileName, std::ios::binary};
+  std::ostringstream content;
+  content << fis.rdbuf();
+  return content.str();
+}
+
+/*!
+ * Collects all changeable entities from the JSON representation of the AudioScene, which only
+ * contains the interactivity properties the user is allowed to change.
+ */
+static void collectTargets(const Json::Value& scene,
+                           std::vector<SChangeTarget> (&outTargets)[NUM_CHANGE_KINDS]) {
+  for (const auto& preset : scene["audioPresets"]) {
+    const auto presetId = preset["id"].asInt();
+    outTargets[PRESET].push_back(SChangeTarget{presetId, presetId, 0, 0, {}});
+
+    for (const auto& object : preset["objects"]) {
+      const auto id = object["id"].asInt();
+      if (object.isMember("prominence")) {
+        const auto& prop = object["prominence"];
+        outTargets[PROMINENCE].push_back(
+            SChangeTarget{presetId, id, prop["min"].asDouble(), prop["max"].asDouble(), {}});
+      }
+      if (object.isMember("muting")) {
+        outTargets[MUTING].push_back(SChangeTarget{presetId, id, 0, 1, {}});
+      }
+      if (object.isMember("azimuth")) {
+        const auto& prop = object["azimuth"];
+        outTargets[AZIMUTH].push_back(
+            SChangeTarget{presetId, id, prop["min"].asDouble(), prop["max"].asDouble(), {}});
+      }
+      if (object.isMember("elevation")) {
+        const auto& prop = object["elevation"];
+        outTargets[ELEVATION].push_back(
+            SChangeTarget{presetId, id, prop["min"].asDouble(), prop["max"].asDouble(), {}});
+      }
+    }
+
+    for (const auto& switchGroup : preset["switchGroups"]) {
+      const auto id = switchGroup["id"].asInt();
+      SChangeTarget target{presetId, id, 0, 1, {}};
+      for (const auto& item : switchGroup["objects"]) {
+        target.itemIds.push_back(item["id"].asInt());
+      }
+      if (!target.itemIds.empty()) {
+        outTargets[SWITCH_GROUP_ITEM].push_back(target);
+      }
+      if (switchGroup.isMember("muting")) {
+        outTargets[SWITCH_GROUP_MUTING].push_back(target);
+      }
+    }
+  }
+}
+
+/*!
+ * Returns a random value in the given range, rounded to two decimal places.
+ */
+static double generateValue(CSplitMix64& rng, double minValue, double maxValue) {
+  const auto value = minValue + rng.nextDouble() * (maxValue - minValue);
+  return std::max(minValue, std::min(maxValue, std::round(value * 100.0) / 100.0));
+}
+
+static Json::Value& findOrAppendEntry(Json::Value& list, int id) {
+  for (auto& entry : list) {
+    if (entry["id"].asInt() == id) {
+      return entry;
+    }
+  }
+  auto& entry = list.append(Json::Value{});
+  entry["id"] = id;
+  return entry;
+}
+
+static void addChange(CSplitMix64& rng, EChangeKind kind, const SChangeTarget& target,
+                      Json::Value& outPresets) {
+  auto& preset = findOrAppendEntry(outPresets, target.presetId);
+  switch (kind) {
+    case PRESET:
+      preset["active"] = true;
+      break;
+    case PROMINENCE:
+      findOrAppendEntry(preset["objects"], target.id)["prominence"]["level"] =
+          generateValue(rng, target.minValue, target.maxValue);
+      break;
+    case MUTING:
+      findOrAppendEntry(preset["objects"], target.id)["muting"]["value"] = rng.nextBool();
+      break;
+    case AZIMUTH:
+      findOrAppendEntry(preset["objects"], target.id)["azimuth"]["offset"] =
+          generateValue(rng, target.minValue, target.maxValue);
+      break;
+    case ELEVATION:
+      findOrAppendEntry(preset["objects"], target.id)["elevation"]["offset"] =
+          generateValue(rng, target.minValue, target.maxValue);
+      break;
+    case SWITCH_GROUP_ITEM:
+      findOrAppendEntry(preset["switchGroups"], target.id)["activeObject"] =
+          target.itemIds[rng.nextIndex(target.itemIds.size())];
+      break;
+    case SWITCH_GROUP_MUTING:
+      findOrAppendEntry(preset["switchGroups"], target.id)["muting"]["value"] = rng.nextBool();
+      break;
+    default:
+      break;
+  }
+}
+
+static bool parseMix(const std::string& mix, double (&outWeights)[NUM_CHANGE_KINDS]) {
+  std::fill(std::begin(outWeights), std::end(outWeights), 0.0);
+
+  std::istringstream entries{mix};
+  std::string entry;
+  while (std::getline(entries, entry, ',')) {
+    const auto separator = entry.find('=');
+    const auto name = entry.substr(0, separator);
+    const auto it = std::find(std::begin(CHANGE_KIND_NAMES), std::end(CHANGE_KIND_NAMES), name);
+    if (separator == std::string::npos || it == std::end(CHANGE_KIND_NAMES)) {
+      return false;
+    }
+    outWeights[it - std::begin(CHANGE_KIND_NAMES)] = std::strtod(entry.c_str() + separator + 1,
+                                                                 nullptr);
+  }
+  return true;
+}
+
+static void printUsage() {
+  std::cout << "Usage: <program> [options] <AudioScene XML file>" << std::endl
+            << "Writes a stream of scene changes JSON documents, which are valid for the given"
+            << std::endl
+            << "AudioScene, to stdout (one document per line)." << std::endl
+            << "  --seed <number>      Seed of the generator (default 0)" << std::endl
+            << "  --count <number>     Number of documents (default 100)" << std::endl
+            << "  --batch <min>[-max]  Number of changes per document (default 1)" << std::endl
+            << "  --mix <kind>=<weight>,...  Relative frequency of the change kinds preset,"
+            << std::endl
+            << "                       prominence, muting, azimuth, elevation, switch and"
+            << std::endl
+            << "                       switch-muting (default preset=1,prominence=4,muting=2,"
+            << std::endl
+            << "                       azimuth=1,elevation=1,switch=2,switch-muting=1)" << std::endl
+            << "  --nul                Terminate the documents with NUL instead of a line break,"
+            << std::endl
+            << "                       e.g. for the stream mode of json_to_xml" << std::endl;
+}
+
+int main(int argc, char** argv) {
+  SOptions options{};
+  const char* xmlFile = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    const std::string option{argv[i]};
+    if (option == "--nul") {
+      options.isNulDelimited = true;
+    } else if (option == "--seed" && i + 1 < argc) {
+      options.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (option == "--count" && i + 1 < argc) {
+      options.numDocuments = std::strtoul(argv[++i], nullptr, 10);
+    } else if (option == "--batch" && i + 1 < argc) {
+      char* end = nullptr;
+      options.minBatchSize = std::strtoul(argv[++i], &end, 10);
+      options.maxBatchSize =
+          *end == '-' ? std::strtoul(end + 1, nullptr, 10) : options.minBatchSize;
+    } else if (option == "--mix" && i + 1 < argc) {
+      if (!parseMix(argv[++i], options.weights)) {
+        printUsage();
+        return EXIT_FAILURE;
+      }
+    } else if (xmlFile == nullptr && option.compare(0, 2, "--") != 0) {
+      xmlFile = argv[i];
+    } else {
+      printUsage();
+      return EXIT_FAILURE;
+    }
+  }
+  if (xmlFile == nullptr || options.minBatchSize > options.maxBatchSize) {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+
+  // Use the public JSON representation to only generate changes the translator accepts
+  Json::Value scene{};
+  try {
+    mpeghuitranslator::CUiTranslator translator{"eng"};
+    scene = translator.mpeghInteractivityToJson(readFile(xmlFile));
+  } catch (const std::exception& e) {
+    std::cerr << xmlFile << ": " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<SChangeTarget> targets[NUM_CHANGE_KINDS];
+  collectTargets(scene, targets);
+
+  double totalWeight = 0;
+  for (std::size_t kind = 0; kind < NUM_CHANGE_KINDS; ++kind) {
+    if (targets[kind].empty()) {
+      options.weights[kind] = 0;
+    }
+    totalWeight += options.weights[kind];
+  }
+  if (totalWeight <= 0) {
+    std::cerr << "The AudioScene contains none of the requested change kinds" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  CSplitMix64 rng{options.seed};
+  Json::StreamWriterBuilder builder{};
+  builder["indentation"] = "";
+  builder["precision"] = 6;
+  for (std::size_t document = 0; document < options.numDocuments; ++document) {
+    Json::Value changes{};
+    changes["uuid"] = scene["uuid"];
+    auto& presets = changes["audioPresets"] = Json::Value{Json::arrayValue};
+
+    const auto batchSize = static_cast<std::size_t>(
+        rng.nextInRange(static_cast<std::int64_t>(options.minBatchSize),
+                        static_cast<std::int64_t>(options.maxBatchSize)));
+    for (std::size_t change = 0; change < batchSize; ++change) {
+      // weighted choice of the change kind, then uniform choice of the changed entity
+      auto choice = rng.nextDouble() * totalWeight;
+      std::size_t kind = 0;
+      for (std::size_t candidateKind = 0; candidateKind < NUM_CHANGE_KINDS; ++candidateKind) {
+        if (options.weights[candidateKind] <= 0) {
+          continue;
+        }
+        // also the fallback for rounding errors of the accumulated weights
+        kind = candidateKind;
+        if (choice < options.weights[candidateKind]) {
+          break;
+        }
+        choice -= options.weights[candidateKind];
+      }
+      const auto& candidates = targets[kind];
+      addChange(rng, static_cast<EChangeKind>(kind), candidates[rng.nextIndex(candidates.size())],
+                presets);
+    }
+
+    std::cout << Json::writeString(builder, changes) << (options.isNulDelimited ? '\0' : '\n');
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -83,6 +83,7 @@ amm-info@iis.fraunhofer.de
 // Internal headers
 #include "mpeghuitranslator/translator.h"
 #include "mpeghuitranslator/simple.h"
+#include "stream_helper.h"
 
 // External headers
 #include "json/json.h"
@@ -92,6 +93,9 @@ amm-info@iis.fraunhofer.de
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 
 static std::string readFile(const char* fileName) {
   std::ifstream fis{fileName};
@@ -149,15 +153,85 @@ static int convertWithoutReference(const char* jsonFile) {
   return EXIT_SUCCESS;
 }
 
+/*!
+ * Creates a stream mode session with its own translator, optionally initialized with the given
+ * baseline XML file. Documents starting with '<' are AudioScene XML updates of the session and are
+ * answered with an empty document, all other documents are translated as scene changes JSON.
+ */
+static DocumentHandler createStreamSession(const char* xmlFile) {
+  auto translator = std::make_shared<mpeghuitranslator::CUiTranslator>("eng");
+  if (xmlFile != nullptr) {
+    std::ignore = translator->mpeghInteractivityToJson(readFile(xmlFile));
+  }
+
+  std::shared_ptr<Json::CharReader> jsonReader{Json::CharReaderBuilder{}.newCharReader()};
+  return [translator, jsonReader](const std::string& document) -> std::string {
+    if (!document.empty() && document[0] == '<') {
+      std::ignore = translator->mpeghInteractivityToJson(document);
+      return {};
+    }
+
+    Json::Value json{};
+    Json::String errors{};
+    if (!jsonReader->parse(document.data(),
+                           document.data() + static_cast<std::ptrdiff_t>(document.size()), &json,
+                           &errors)) {
+      throw std::runtime_error{"Failed to read the input JSON: " + errors};
+    }
+
+    std::string result;
+    for (const auto& event : translator->mpeghInteractivityToXml(json)) {
+      result += event;
+      result += '\n';
+    }
+    return result;
+  };
+}
+
+static void printUsage() {
+  std::cout << "Usage: <program> <JSON file> [<baseline XML file>]" << std::endl
+            << "       <program> --stream nul|length [--socket <path>] [<baseline XML file>]"
+            << std::endl
+            << STREAM_OPTIONS_USAGE;
+}
+
 int main(int argc, char** argv) {
-  if (argc != 2 && argc != 3) {
-    std::cout << "Usage: <program> <JSON file> [<baseline XML file>]" << std::endl;
+  SStreamOptions streamOptions{};
+  std::vector<const char*> fileNames;
+  for (int i = 1; i < argc; ++i) {
+    int numConsumed = 0;
+    try {
+      numConsumed = parseStreamOption(i, argc, argv, streamOptions);
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << std::endl;
+      printUsage();
+      return EXIT_FAILURE;
+    }
+
+    if (numConsumed > 0) {
+      i += numConsumed - 1;
+    } else {
+      fileNames.push_back(argv[i]);
+    }
+  }
+
+  if (streamOptions.isEnabled) {
+    if (fileNames.size() > 1) {
+      printUsage();
+      return EXIT_FAILURE;
+    }
+    const char* xmlFile = fileNames.empty() ? nullptr : fileNames[0];
+    return runStreamMode(streamOptions, [xmlFile]() { return createStreamSession(xmlFile); });
+  }
+
+  if (fileNames.size() != 1 && fileNames.size() != 2) {
+    printUsage();
     return EXIT_FAILURE;
   }
 
-  if (argc == 3) {
-    return convertWithReference(argv[1], argv[2]);
+  if (fileNames.size() == 2) {
+    return convertWithReference(fileNames[0], fileNames[1]);
   } else {
-    return convertWithoutReference(argv[1]);
+    return convertWithoutReference(fileNames[0]);
   }
 }
@@ -0,0 +1,241 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// Internal headers
+#include "mpeghuitranslator/trace.h"
+#include "mpeghuitranslator/translator.h"
+
+// External headers
+#include "json/json.h"
+
+// System headers
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using SClock = std::chrono::steady_clock;
+
+/*!
+ * Latencies of all calls of a single translator API in microseconds.
+ */
+struct SApiStatistics {
+  std::vector<double> latencies;
+  std::size_t numErrors = 0;
+};
+
+static double percentile(const std::vector<double>& sortedValues, double fraction) {
+  if (sortedValues.empty()) {
+    return 0.0;
+  }
+  // nearest-rank percentile
+  auto rank =
+      static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(sortedValues.size())));
+  return sortedValues[std::max<std::size_t>(rank, 1) - 1];
+}
+
+static void printStatistics(const std::string& api, SApiStatistics& stats, double seconds) {
+  std::sort(stats.latencies.begin(), stats.latencies.end());
+  std::cout << api << ": " << stats.latencies.size() << " calls (" << stats.numErrors
+            << " errors), " << static_cast<double>(stats.latencies.size()) / seconds
+            << " calls/s, latency [us] p50 " << percentile(stats.latencies, 0.5) << ", p99 "
+            << percentile(stats.latencies, 0.99) << ", p999 " << percentile(stats.latencies, 0.999)
+            << std::endl;
+}
+
+static void printUsage() {
+  std::cout << "Usage: <program> [--realtime] [--repeat <count>] <trace file>" << std::endl
+            << "  --realtime        Replay with the recorded timing instead of at maximum speed"
+            << std::endl
+            << "  --repeat <count>  Replay the trace the given number of times" << std::endl;
+}
+
+int main(int argc, char** argv) {
+  bool isRealtime = false;
+  std::size_t numRepetitions = 1;
+  const char* traceFile = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--realtime") == 0) {
+      isRealtime = true;
+    } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+      numRepetitions = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (traceFile == nullptr) {
+      traceFile = argv[i];
+    } else {
+      printUsage();
+      return EXIT_FAILURE;
+    }
+  }
+  if (traceFile == nullptr) {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+
+  // Load the whole trace up front to not measure the trace file I/O
+  std::vector<mpeghuitranslator::STraceRecord> records;
+  std::vector<Json::Value> sceneChanges;
+  try {
+    std::ifstream input{traceFile, std::ios::binary};
+    mpeghuitranslator::CTraceReader reader{input};
+    mpeghuitranslator::STraceRecord record{};
+    while (reader.next(record)) {
+      records.push_back(record);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << traceFile << ": " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Parse the scene changes JSON up front as well, it is not part of the measured API call
+  std::unique_ptr<Json::CharReader> jsonReader{Json::CharReaderBuilder{}.newCharReader()};
+  for (const auto& record : records) {
+    Json::Value json{};
+    if (record.input == mpeghuitranslator::ETraceInput::kSceneChangesJson) {
+      Json::String errors{};
+      if (!jsonReader->parse(record.data.data(), record.data.data() + record.data.size(), &json,
+                             &errors)) {
+        std::cerr << "Failed to read the scene changes JSON in the trace: " << errors << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    sceneChanges.push_back(std::move(json));
+  }
+
+  std::map<std::string, SApiStatistics> statistics;
+  auto& toJsonStats = statistics["mpeghInteractivityToJson"];
+  auto& toXmlStats = statistics["mpeghInteractivityToXml"];
+
+  const auto startTime = SClock::now();
+  for (std::size_t repetition = 0; repetition < numRepetitions; ++repetition) {
+    // every repetition replays the session with a fresh translator, traces without a recorded
+    // display language fall back to English
+    std::unique_ptr<mpeghuitranslator::CUiTranslator> translator{
+        new mpeghuitranslator::CUiTranslator("eng")};
+    const auto repetitionStartTime = SClock::now();
+
+    for (std::size_t i = 0; i < records.size(); ++i) {
+      const auto& record = records[i];
+      if (record.input == mpeghuitranslator::ETraceInput::kDisplayLanguage) {
+        // the recording was attached to a translator with this display language
+        translator.reset(new mpeghuitranslator::CUiTranslator(record.data));
+        continue;
+      }
+      if (isRealtime) {
+        std::this_thread::sleep_until(repetitionStartTime +
+                                      std::chrono::microseconds(record.timestamp));
+      }
+
+      const bool isAudioScene = record.input == mpeghuitranslator::ETraceInput::kAudioSceneXml;
+      auto& stats = isAudioScene ? toJsonStats : toXmlStats;
+      const auto callStartTime = SClock::now();
+      try {
+        if (isAudioScene) {
+          std::ignore = translator->mpeghInteractivityToJson(record.data);
+        } else {
+          std::ignore = translator->mpeghInteractivityToXml(sceneChanges[i]);
+        }
+      } catch (const std::exception&) {
+        ++stats.numErrors;
+      }
+      stats.latencies.push_back(
+          std::chrono::duration<double, std::micro>(SClock::now() - callStartTime).count());
+    }
+  }
+  const auto seconds = std::chrono::duration<double>(SClock::now() - startTime).count();
+
+  std::cout << "Replayed " << records.size() << " records " << numRepetitions << " times in "
+            << seconds << " s (" << (isRealtime ? "real-time" : "maximum speed") << ")"
+            << std::endl;
+  for (auto& entry : statistics) {
+    printStatistics(entry.first, entry.second, seconds);
+  }
+
+  return EXIT_SUCCESS;
+}
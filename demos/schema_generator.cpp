@@ -80,145 +80,242 @@ www.iis.fraunhofer.de/amm
 amm-info@iis.fraunhofer.de
 -----------------------------------------------------------------------------*/
 
+#include "audio_scene_generator_helper.h"
 #include "schema_validator_helper.h"
 
-#include "json/value.h"
+#include "json/json.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <random>
+#include <sstream>
 #include <string>
-
-static std::size_t SEED = []() {
-  std::random_device dev;
-  return dev();
-}();
-
-static bool generateRandomBool() {
-  static std::default_random_engine rng{static_cast<std::default_random_engine::result_type>(SEED)};
-  static std::uniform_int_distribution<uint16_t> dist{0, 1};
-  return dist(rng) == 1U;
+#include <thread>
+#include <vector>
+
+// Number of documents generated by a worker at once in JSON Lines mode
+static constexpr std::size_t DOCUMENTS_PER_CHUNK = 256;
+
+/*!
+ * Returns the seed of the random generator of the document with the given index, so that every
+ * document can be reproduced on its own from the global seed and its index.
+ */
+static std::uint64_t getDocumentSeed(std::uint64_t seed, std::uint64_t documentIndex) {
+  CSplitMix64 mixer{seed + documentIndex};
+  return mixer.next();
 }
 
-static float generateRandomNumber() {
-  static std::default_random_engine rng{static_cast<std::default_random_engine::result_type>(SEED)};
-  static std::uniform_real_distribution<float> dist{-128.0f, 128.0f};
-  return dist(rng);
+static bool generateRandomBool(CSplitMix64& rng) { return rng.nextBool(); }
+
+static float generateRandomNumber(CSplitMix64& rng) {
+  return static_cast<float>(rng.nextDouble() * 256.0 - 128.0);
 }
 
-static int64_t generateRandomInteger(int64_t minValue = 0,
+static int64_t generateRandomInteger(CSplitMix64& rng, int64_t minValue = 0,
                                      int64_t maxValue = std::numeric_limits<int64_t>::max()) {
-  static std::default_random_engine rng{static_cast<std::default_random_engine::result_type>(SEED)};
-  static std::uniform_real_distribution<double> dist{0.0, 1.0f};
-
-  auto valueRange = static_cast<double>(std::max(minValue, maxValue)) -
-                    static_cast<double>(std::min(minValue, maxValue));
-  auto relativeValue = dist(rng) * valueRange;
-  return std::min(minValue, maxValue) + static_cast<int64_t>(std::round(relativeValue));
+  return rng.nextInRange(std::min(minValue, maxValue), std::max(minValue, maxValue));
 }
 
-static char generateRandomLetter() {
-  static std::default_random_engine rng{static_cast<std::default_random_engine::result_type>(SEED)};
+static char generateRandomLetter(CSplitMix64& rng) {
   // only generate lower case letters
-  static std::uniform_int_distribution<short> dist{'a', 'z'};
-  return static_cast<char>(dist(rng));
+  return static_cast<char>('a' + rng.nextIndex(26));
 }
 
-static Json::Value generateRandomMembers(const SSchema& schema,
+static Json::Value generateRandomMembers(CSplitMix64& rng, const SSchema& schema,
                                          const std::map<std::string, SSchema>& schemas);
 
-static std::size_t generateLength(const COptionalValue<std::size_t>& minValue,
+static std::size_t generateLength(CSplitMix64& rng, const COptionalValue<std::size_t>& minValue,
                                   const COptionalValue<std::size_t>& maxValue) {
   if (!minValue && !maxValue) {
     // arbitrary upper bound to not have too long lists/strings
-    return static_cast<std::size_t>(generateRandomInteger(0, 4));
+    return static_cast<std::size_t>(generateRandomInteger(rng, 0, 4));
   } else if (minValue.value == maxValue.value) {
     return minValue.value;
   }
-  return static_cast<std::size_t>(generateRandomInteger(static_cast<int64_t>(minValue.value),
-                                                        static_cast<int64_t>(maxValue.value)));
+  return static_cast<std::size_t>(generateRandomInteger(
+      rng, static_cast<int64_t>(minValue.value), static_cast<int64_t>(maxValue.value)));
 }
 
-static Json::Value generateRandomValue(const SProperty& property,
+static Json::Value generateRandomValue(CSplitMix64& rng, const SProperty& property,
                                        const std::map<std::string, SSchema>& schemas) {
   if (property.type == "array" && property.format.empty() && !property.itemType.empty()) {
     Json::Value array{Json::arrayValue};
     auto itemProp = property;
     itemProp.type = property.itemType;
-    auto numItems = generateLength(property.minLength, property.maxLength);
+    auto numItems = generateLength(rng, property.minLength, property.maxLength);
     for (std::size_t i = 0; i < numItems; ++i) {
-      array.append(generateRandomValue(itemProp, schemas));
+      array.append(generateRandomValue(rng, itemProp, schemas));
     }
     return array;
   } else if (property.type == "boolean" && property.format.empty()) {
-    return Json::Value{generateRandomBool()};
+    return Json::Value{generateRandomBool(rng)};
   } else if (property.type == "integer" && property.format.empty()) {
     if (property.minValue || property.maxValue) {
-      return Json::Value{generateRandomInteger(property.minValue.value, property.maxValue.value)};
+      return Json::Value{
+          generateRandomInteger(rng, property.minValue.value, property.maxValue.value)};
     } else {
-      return Json::Value{generateRandomInteger()};
+      return Json::Value{generateRandomInteger(rng)};
     }
   } else if (property.type == "number" && property.format.empty() && !property.minLength &&
              !property.maxLength) {
-    return Json::Value{generateRandomNumber()};
+    return Json::Value{generateRandomNumber(rng)};
   } else if (property.type == "string" && property.format == "uuid") {
     // random value
     return Json::Value{"123e4567-e89b-12d3-a456-426614174000"};
   } else if (property.type == "string" && property.format.empty()) {
-    auto length = generateLength(property.minLength, property.maxLength);
+    auto length = generateLength(rng, property.minLength, property.maxLength);
     std::string tmp(length, '\0');
     for (auto& c : tmp) {
-      c = generateRandomLetter();
+      c = generateRandomLetter(rng);
     }
     return Json::Value{tmp};
   } else if (schemas.find(property.type) != schemas.end()) {
-    return generateRandomMembers(schemas.at(property.type), schemas);
+    return generateRandomMembers(rng, schemas.at(property.type), schemas);
   } else {
     std::cerr << "Unhandled property: " << property << std::endl;
     return {};
   }
 }
 
-static Json::Value generateRandomMembers(const SSchema& schema,
+static Json::Value generateRandomMembers(CSplitMix64& rng, const SSchema& schema,
                                          const std::map<std::string, SSchema>& schemas) {
   Json::Value object{};
   if (schema.properties.size() == 1 && schema.properties.front().name == TOP_LEVEL_PROPERTY) {
-    return generateRandomValue(schema.properties.front(), schemas);
+    return generateRandomValue(rng, schema.properties.front(), schemas);
   }
   for (const auto& prop : schema.properties) {
-    if (!prop.required && !generateRandomBool()) {
+    if (!prop.required && !generateRandomBool(rng)) {
       // randomly skip non-required properties
       continue;
     }
-    object[prop.name] = generateRandomValue(prop, schemas);
+    object[prop.name] = generateRandomValue(rng, prop, schemas);
   }
   return object;
 }
 
+static Json::Value generateDocument(const SSchemas& schemas, std::uint64_t seed,
+                                    std::uint64_t documentIndex) {
+  CSplitMix64 rng{getDocumentSeed(seed, documentIndex)};
+  return generateRandomMembers(rng, schemas.root, schemas.schemas);
+}
+
+/*!
+ * Writes the given number of documents as JSON Lines, generated by the given number of worker
+ * threads. The documents are written in index order, independent of the number of workers.
+ */
+static void generateJsonLines(const SSchemas& schemas, std::uint64_t seed,
+                              std::uint64_t numDocuments, std::size_t numWorkers) {
+  const auto numChunks = (numDocuments + DOCUMENTS_PER_CHUNK - 1) / DOCUMENTS_PER_CHUNK;
+  // Limit the number of finished but not yet written chunks
+  const auto maxChunksInFlight = 4 * numWorkers;
+
+  std::atomic<std::uint64_t> nextChunk{0};
+  std::mutex lock;
+  std::condition_variable chunkDone;
+  std::condition_variable chunkWritten;
+  std::map<std::uint64_t, std::string> finishedChunks;
+  std::uint64_t nextChunkToWrite = 0;
+
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0; i < numWorkers; ++i) {
+    workers.emplace_back([&]() {
+      Json::StreamWriterBuilder builder{};
+      builder["indentation"] = "";
+      std::unique_ptr<Json::StreamWriter> writer{builder.newStreamWriter()};
+
+      std::uint64_t chunk;
+      while ((chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) < numChunks) {
+        {
+          std::unique_lock<std::mutex> guard{lock};
+          chunkWritten.wait(guard, [&]() { return chunk < nextChunkToWrite + maxChunksInFlight; });
+        }
+
+        std::ostringstream out;
+        const auto firstDocument = chunk * DOCUMENTS_PER_CHUNK;
+        const auto endDocument = std::min(firstDocument + DOCUMENTS_PER_CHUNK, numDocuments);
+        for (auto index = firstDocument; index < endDocument; ++index) {
+          writer->write(generateDocument(schemas, seed, index), &out);
+          out << '\n';
+        }
+
+        {
+          std::lock_guard<std::mutex> guard{lock};
+          finishedChunks.emplace(chunk, out.str());
+        }
+        chunkDone.notify_all();
+      }
+    });
+  }
+
+  for (std::uint64_t chunk = 0; chunk < numChunks; ++chunk) {
+    std::string output;
+    {
+      std::unique_lock<std::mutex> guard{lock};
+      chunkDone.wait(guard, [&]() { return finishedChunks.count(chunk) > 0; });
+      output = std::move(finishedChunks[chunk]);
+      finishedChunks.erase(chunk);
+      nextChunkToWrite = chunk + 1;
+    }
+    chunkWritten.notify_all();
+    std::cout << output;
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  std::cout.flush();
+}
+
 int printHelpAndExit() {
-  std::cerr << "Usage: <program> [--seed <numerical seed>] <schema files>..." << std::endl;
+  std::cerr << "Usage: <program> [--seed <numerical seed>] [--count <number of documents> [-j "
+               "<number of workers, 0 for all cores>]] <schema files>..."
+            << std::endl
+            << "  --count  Write the given number of documents as JSON Lines instead of a single "
+               "pretty-printed document. Document i only depends on the seed and i."
+            << std::endl;
   return EXIT_FAILURE;
 }
 
 int main(int argc, char** argv) {
-  if (argc < 2) {
-    return printHelpAndExit();
-  }
+  std::uint64_t seed = std::random_device{}();
+  std::uint64_t numDocuments = 0;
+  std::size_t numWorkers = 1;
 
   int skipArgs = 1;
-
-  if (std::string{"--seed"} == argv[1]) {
-    if (argc < 4) {
-      return printHelpAndExit();
+  for (; skipArgs < argc; ++skipArgs) {
+    const char* arg = argv[skipArgs];
+    if (std::strcmp(arg, "--seed") == 0 && skipArgs + 1 < argc) {
+      seed = std::strtoull(argv[++skipArgs], nullptr, 0);
+    } else if (std::strcmp(arg, "--count") == 0 && skipArgs + 1 < argc) {
+      numDocuments = std::strtoull(argv[++skipArgs], nullptr, 0);
+    } else if (std::strcmp(arg, "-j") == 0 && skipArgs + 1 < argc) {
+      numWorkers = static_cast<std::size_t>(std::strtoul(argv[++skipArgs], nullptr, 10));
+      if (numWorkers == 0) {
+        numWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+      }
+    } else {
+      break;
     }
-    SEED = std::strtoull(argv[2], nullptr, 0);
-    skipArgs += 2;
+  }
+  if (skipArgs >= argc) {
+    return printHelpAndExit();
   }
 
   auto schemas = parseSchemas(argc - skipArgs, argv + skipArgs);
 
-  auto root = generateRandomMembers(schemas.root, schemas.schemas);
-  printJson(root, std::cout);
+  if (numDocuments > 0) {
+    std::cerr << "Seed: " << seed << std::endl;
+    generateJsonLines(schemas, seed, numDocuments, numWorkers);
+    return EXIT_SUCCESS;
+  }
+
+  printJson(generateDocument(schemas, seed, 0), std::cout);
   return EXIT_SUCCESS;
 }
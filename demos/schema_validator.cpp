@@ -82,21 +82,243 @@ amm-info@iis.fraunhofer.de
 
 #include "schema_validator_helper.h"
 
-#include "json/value.h"
+#include "json/json.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Number of JSON Lines handed to a worker at once
+static constexpr std::size_t LINES_PER_BATCH = 1024;
+
+/*!
+ * Consecutive JSON Lines validated by a single worker.
+ */
+struct SLineBatch {
+  // Line number of the first line (1-based)
+  std::size_t firstLine = 0;
+  std::vector<std::string> lines;
+  // Report line per invalid document, in line order
+  std::string reports;
+  std::size_t numDocuments = 0;
+  std::size_t numInvalid = 0;
+  bool isDone = false;
+};
+
+static void validateBatch(const CSchemaValidator& validator, Json::CharReader& reader,
+                          Json::StreamWriter& writer, SLineBatch& batch) {
+  std::vector<SValidationError> errors;
+  std::ostringstream reports;
+  for (std::size_t i = 0; i < batch.lines.size(); ++i) {
+    const auto& line = batch.lines[i];
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    ++batch.numDocuments;
+
+    errors.clear();
+    Json::Value value{};
+    std::string parseErrors;
+    if (!reader.parse(line.data(), line.data() + line.size(), &value, &parseErrors)) {
+      errors.push_back(SValidationError{"", "Invalid JSON: " + parseErrors});
+    } else {
+      validator.validate(value, errors);
+    }
+    if (errors.empty()) {
+      continue;
+    }
+
+    ++batch.numInvalid;
+    Json::Value report{};
+    report["line"] = static_cast<Json::UInt64>(batch.firstLine + i);
+    auto& reportErrors = report["errors"];
+    for (const auto& error : errors) {
+      Json::Value entry{};
+      entry["pointer"] = error.pointer;
+      entry["message"] = error.message;
+      reportErrors.append(std::move(entry));
+    }
+    writer.write(report, &reports);
+    reports << '\n';
+  }
+  batch.lines.clear();
+  batch.reports = reports.str();
+}
+
+/*!
+ * Validates every line of the given input as separate JSON document with the given number of
+ * worker threads and prints one JSON report line per invalid document in input order.
+ *
+ * The input is read in batches while validating, at most a few batches per worker are held in
+ * memory at any time.
+ */
+static int runJsonLines(const CSchemaValidator& validator, std::istream& input,
+                        std::size_t numWorkers) {
+  const auto startTime = std::chrono::steady_clock::now();
+  const auto maxBatchesInFlight = 4 * numWorkers;
+
+  std::mutex lock;
+  std::condition_variable batchAvailable;
+  std::condition_variable batchDone;
+  // Batches in input order, the first ones not yet taken by a worker are in pendingBatches as well
+  std::deque<std::shared_ptr<SLineBatch>> batchesInFlight;
+  std::deque<std::shared_ptr<SLineBatch>> pendingBatches;
+  bool isInputDone = false;
+
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0; i < numWorkers; ++i) {
+    workers.emplace_back([&]() {
+      std::unique_ptr<Json::CharReader> reader{Json::CharReaderBuilder{}.newCharReader()};
+      Json::StreamWriterBuilder builder{};
+      builder["indentation"] = "";
+      std::unique_ptr<Json::StreamWriter> writer{builder.newStreamWriter()};
+
+      while (true) {
+        std::shared_ptr<SLineBatch> batch;
+        {
+          std::unique_lock<std::mutex> guard{lock};
+          batchAvailable.wait(guard, [&]() { return !pendingBatches.empty() || isInputDone; });
+          if (pendingBatches.empty()) {
+            return;
+          }
+          batch = std::move(pendingBatches.front());
+          pendingBatches.pop_front();
+        }
+
+        validateBatch(validator, *reader, *writer, *batch);
+
+        {
+          std::lock_guard<std::mutex> guard{lock};
+          batch->isDone = true;
+        }
+        batchDone.notify_all();
+      }
+    });
+  }
+
+  std::size_t numDocuments = 0;
+  std::size_t numInvalid = 0;
+  std::size_t numBytes = 0;
+  std::size_t nextLine = 1;
+  bool hasMoreInput = true;
+  while (true) {
+    // Keep the workers busy with new batches while writing the finished ones in order
+    while (hasMoreInput && batchesInFlight.size() < maxBatchesInFlight) {
+      auto batch = std::make_shared<SLineBatch>();
+      batch->firstLine = nextLine;
+      std::string line;
+      while (batch->lines.size() < LINES_PER_BATCH && std::getline(input, line)) {
+        numBytes += line.size() + 1;
+        batch->lines.push_back(std::move(line));
+      }
+      hasMoreInput = batch->lines.size() == LINES_PER_BATCH;
+      if (batch->lines.empty()) {
+        break;
+      }
+      nextLine += batch->lines.size();
+
+      std::lock_guard<std::mutex> guard{lock};
+      batchesInFlight.push_back(batch);
+      pendingBatches.push_back(std::move(batch));
+      batchAvailable.notify_one();
+    }
+    if (batchesInFlight.empty()) {
+      break;
+    }
+
+    std::shared_ptr<SLineBatch> batch;
+    {
+      std::unique_lock<std::mutex> guard{lock};
+      batchDone.wait(guard, [&]() { return batchesInFlight.front()->isDone; });
+      batch = std::move(batchesInFlight.front());
+      batchesInFlight.pop_front();
+    }
+    std::cout << batch->reports;
+    numDocuments += batch->numDocuments;
+    numInvalid += batch->numInvalid;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard{lock};
+    isInputDone = true;
+  }
+  batchAvailable.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  std::cout.flush();
+
+  const auto seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+  std::cerr << "Validated " << numDocuments << " documents (" << numBytes << " bytes) in "
+            << seconds << " s with " << numWorkers << " workers, " << numInvalid
+            << " invalid: " << static_cast<double>(numDocuments) / seconds << " documents/s, "
+            << static_cast<double>(numBytes) / seconds / 1e6 << " MB/s" << std::endl;
+  return numInvalid == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static void printUsage() {
+  std::cerr << "Usage: <program> <json file> <schema files>..." << std::endl
+            << "       <program> --jsonl <JSON Lines file or - for stdin> [-j <number of workers, "
+               "0 for all cores>] <schema files>..."
+            << std::endl
+            << "  --jsonl  Validate every line as separate JSON document and print one JSON "
+               "object {\"line\", \"errors\": [{\"pointer\", \"message\"}]} per invalid "
+               "document"
+            << std::endl;
+}
 
 int main(int argc, char** argv) {
+  if (argc >= 2 && std::strcmp(argv[1], "--jsonl") == 0) {
+    if (argc < 4) {
+      printUsage();
+      return EXIT_FAILURE;
+    }
+    const char* inputFile = argv[2];
+    int firstSchema = 3;
+    std::size_t numWorkers = 0;
+    if (std::strcmp(argv[3], "-j") == 0 && argc > 5) {
+      numWorkers = static_cast<std::size_t>(std::strtoul(argv[4], nullptr, 10));
+      firstSchema = 5;
+    }
+    if (numWorkers == 0) {
+      numWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    auto schemas = parseSchemas(argc - firstSchema, argv + firstSchema);
+    CSchemaValidator validator{schemas};
+    if (std::strcmp(inputFile, "-") == 0) {
+      return runJsonLines(validator, std::cin, numWorkers);
+    }
+    std::ifstream input{inputFile};
+    if (!input) {
+      std::cerr << "Cannot open " << inputFile << std::endl;
+      return EXIT_FAILURE;
+    }
+    return runJsonLines(validator, input, numWorkers);
+  }
+
   if (argc < 3) {
-    std::cerr << "Usage: <program> <json file> <schema files>..." << std::endl;
+    printUsage();
     return EXIT_FAILURE;
   }
 
   auto json = readJsonFile(argv[1]);
   auto schemas = parseSchemas(argc - 2, argv + 2);
+  CSchemaValidator validator{schemas};
 
-  if (!schemas.validate(json)) {
+  if (!validator.validate(json)) {
     return EXIT_FAILURE;
   }
 
@@ -93,6 +93,7 @@ amm-info@iis.fraunhofer.de
 #include <cctype>
 #include <fstream>
 #include <set>
+#include <sstream>
 #include <stdexcept>
 
 const std::string TOP_LEVEL_PROPERTY = "";
@@ -279,148 +280,334 @@ static bool validateLength(std::size_t value, const COptionalValue<std::size_t>&
   return (!minValue || value >= minValue.value) && (!maxValue || value <= maxValue.value);
 }
 
-static bool validateUuid(const std::string& value) {
+static bool validateUuid(const char* begin, const char* end) {
   // As defined in RFC4122: hexadecimal values in the layout xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
   // where every x represents a nibble (4 bits).
-  for (std::size_t i = 0; i < value.size(); ++i) {
+  for (const auto* it = begin; it != end; ++it) {
+    auto i = it - begin;
     if (i == 8 || i == 13 || i == 18 || i == 23) {
-      if (value[i] != '-') {
+      if (*it != '-') {
         return false;
       }
-    } else if (!std::isxdigit(static_cast<unsigned char>(value[i]))) {
+    } else if (!std::isxdigit(static_cast<unsigned char>(*it))) {
       return false;
     }
   }
   return true;
 }
 
-static bool validateSchema(const Json::Value& value, const SSchema& schema,
-                           const std::map<std::string, SSchema>& schemas);
+static std::size_t getStringSize(const Json::Value& value) {
+  const char* begin = nullptr;
+  const char* end = nullptr;
+  value.getString(&begin, &end);
+  return static_cast<std::size_t>(end - begin);
+}
 
-static bool validateProperty(const Json::Value& value, const SProperty& property,
-                             const std::map<std::string, SSchema>& schemas) {
-  if (property.type == "array" && property.format.empty() && !property.itemType.empty()) {
-    if (!value.isArray()) {
-      std::cerr << "JSON value for array property is not a JSON array (" << property
-                << "): " << value << std::endl;
-      return false;
+CSchemaValidator::CSchemaValidator(const SSchemas& schemas) : m_schemas(schemas), m_root(0) {
+  m_root = compileSchema(schemas.root);
+}
+
+std::size_t CSchemaValidator::compileNode(const std::string& type, const SProperty& property) {
+  SNode node{};
+  node.property = property;
+  node.property.type = type;
+  node.target = 0;
+
+  // Same order of checks as in the interpreting validation before, so that the first matching kind
+  // wins
+  const auto& format = property.format;
+  if (type == "array" && format.empty() && !property.itemType.empty()) {
+    node.kind = EValueKind::kArray;
+  } else if (type == "boolean" && format.empty()) {
+    node.kind = EValueKind::kBoolean;
+  } else if (type == "integer" && format.empty()) {
+    node.kind = EValueKind::kInteger;
+  } else if (type == "number" && format.empty() && !property.minLength && !property.maxLength) {
+    node.kind = EValueKind::kNumber;
+  } else if (type == "string" && format == "uuid") {
+    node.kind = EValueKind::kUuid;
+  } else if (type == "string" && format.empty()) {
+    node.kind = EValueKind::kString;
+  } else if (m_schemas.schemas.find(type) != m_schemas.schemas.end()) {
+    node.kind = EValueKind::kSchema;
+  } else {
+    node.kind = EValueKind::kUnhandled;
+  }
+
+  // Only refer to the node by index from here on, since compiling the targets may grow m_nodes
+  auto index = m_nodes.size();
+  m_nodes.push_back(std::move(node));
+  if (m_nodes[index].kind == EValueKind::kArray) {
+    // The items keep all attributes of the array property except for the type. Arrays of arrays
+    // therefore compile to the same node again.
+    auto target = property.itemType == type ? index : compileNode(property.itemType, property);
+    m_nodes[index].target = target;
+  } else if (m_nodes[index].kind == EValueKind::kSchema) {
+    auto target = compileSchema(m_schemas.schemas.at(type));
+    m_nodes[index].target = target;
+  }
+  return index;
+}
+
+std::size_t CSchemaValidator::compileSchema(const SSchema& schema) {
+  auto schemaIt = m_schemaIndices.find(schema.id);
+  if (schemaIt != m_schemaIndices.end()) {
+    return schemaIt->second;
+  }
+
+  // Register the schema before compiling its properties to support recursive schemas
+  auto index = m_compiledSchemas.size();
+  m_schemaIndices.emplace(schema.id, index);
+  SCompiledSchema compiled{};
+  compiled.schema = &schema;
+  compiled.isTopLevelProperty =
+      schema.properties.size() == 1 && schema.properties.front().name == TOP_LEVEL_PROPERTY;
+  m_compiledSchemas.push_back(std::move(compiled));
+
+  std::vector<std::size_t> propertyNodes{};
+  propertyNodes.reserve(schema.properties.size());
+  for (const auto& prop : schema.properties) {
+    propertyNodes.push_back(compileNode(prop.type, prop));
+  }
+  m_compiledSchemas[index].propertyNodes = std::move(propertyNodes);
+  return index;
+}
+
+/*!
+ * State of a single validation run: either the first error is printed to std::cerr and the
+ * validation stops, or all errors are collected with the JSON Pointer of the current value.
+ */
+struct CSchemaValidator::SContext {
+  std::vector<SValidationError>* errors;
+  std::string pointer;
+
+  bool isCollecting() const noexcept { return errors != nullptr; }
+
+  void report(const std::string& message) {
+    if (errors) {
+      errors->push_back(SValidationError{pointer, message});
+    } else {
+      std::cerr << message << std::endl;
     }
-    if (!validateLength(value.size(), property.minLength, property.maxLength)) {
-      std::cerr << "JSON array size of " << value.size() << "' exceeds bounds: " << property
-                << std::endl;
-      return false;
+  }
+};
+
+namespace {
+
+/*!
+ * Appends a reference token to the JSON Pointer of the given context for its lifetime. Only done
+ * while collecting errors, since the pointer is not needed otherwise.
+ */
+class CPointerToken {
+ public:
+  CPointerToken(std::string& pointer, bool isEnabled, const std::string& token)
+      : m_pointer(pointer), m_size(pointer.size()) {
+    if (isEnabled) {
+      // Escaping as defined in RFC 6901
+      m_pointer += '/';
+      for (auto c : token) {
+        if (c == '~') {
+          m_pointer += "~0";
+        } else if (c == '/') {
+          m_pointer += "~1";
+        } else {
+          m_pointer += c;
+        }
+      }
     }
-    auto itemProp = property;
-    itemProp.type = property.itemType;
-    for (const auto& item : value) {
-      if (!validateProperty(item, itemProp, schemas)) {
+  }
+  CPointerToken(const CPointerToken&) = delete;
+  ~CPointerToken() { m_pointer.resize(m_size); }
+
+  CPointerToken& operator=(const CPointerToken&) = delete;
+
+ private:
+  std::string& m_pointer;
+  std::size_t m_size;
+};
+
+}  // namespace
+
+static void appendToStream(std::ostream&) {}
+
+template <typename T, typename... Args>
+static void appendToStream(std::ostream& os, const T& value, const Args&... args) {
+  os << value;
+  appendToStream(os, args...);
+}
+
+template <typename... Args>
+static std::string concat(const Args&... args) {
+  std::ostringstream os;
+  appendToStream(os, args...);
+  return os.str();
+}
+
+bool CSchemaValidator::validateNode(const Json::Value& value, const SNode& node,
+                                    SContext& context) const {
+  const auto& property = node.property;
+  switch (node.kind) {
+    case EValueKind::kArray: {
+      if (!value.isArray()) {
+        context.report(concat("JSON value for array property is not a JSON array (", property,
+                              "): ", value));
         return false;
       }
+      if (!validateLength(value.size(), property.minLength, property.maxLength)) {
+        context.report(
+            concat("JSON array size of ", value.size(), "' exceeds bounds: ", property));
+        return false;
+      }
+      const auto& itemNode = m_nodes[node.target];
+      bool isValid = true;
+      for (Json::ArrayIndex i = 0; i < value.size(); ++i) {
+        CPointerToken token{context.pointer, context.isCollecting(),
+                            context.isCollecting() ? std::to_string(i) : std::string{}};
+        if (!validateNode(value[i], itemNode, context)) {
+          isValid = false;
+          if (!context.isCollecting()) {
+            return false;
+          }
+        }
+      }
+      return isValid;
     }
-    return true;
-  } else if (property.type == "boolean" && property.format.empty()) {
-    if (!value.isBool()) {
-      std::cerr << "JSON value for bool property is not a JSON bool (" << property << "): " << value
-                << std::endl;
-      return false;
-    }
-    return true;
-  } else if (property.type == "integer" && property.format.empty()) {
-    if (!value.isInt()) {
-      std::cerr << "JSON value for integer property is not a JSON integer (" << property
-                << "): " << value << std::endl;
-      return false;
-    }
-    if ((property.minValue && value.asInt64() < property.minValue.value) ||
-        (property.maxValue && value.asInt64() > property.maxValue.value)) {
-      std::cerr << "JSON integer exceeds bounds (" << property << "): " << value << std::endl;
-      return false;
-    }
-    return true;
-  } else if (property.type == "number" && property.format.empty() && !property.minLength &&
-             !property.maxLength) {
-    if (!value.isNumeric()) {
-      std::cerr << "JSON value for number property is not a JSON number (" << property
-                << "): " << value << std::endl;
-      return false;
-    }
-    return true;
-  } else if (property.type == "string" && property.format == "uuid") {
-    if (!value.isString()) {
-      std::cerr << "JSON value for string property is not a JSON string (" << property
-                << "): " << value << std::endl;
-      return false;
-    }
-    if (!validateLength(value.asString().size(), UUID_LENGTH, UUID_LENGTH)) {
-      std::cerr << "JSON string length of " << value.asString().size() << "' exceeds bounds ("
-                << property << "): " << value << std::endl;
-      return false;
-    }
-    if (!validateUuid(value.asString())) {
-      std::cerr << "JSON string is not a valid UUID (" << property << "): " << value << std::endl;
-      return false;
-    }
-    return true;
-  } else if (property.type == "string" && property.format.empty()) {
-    if (!value.isString()) {
-      std::cerr << "JSON value for string property is not a JSON string (" << property
-                << "): " << value << std::endl;
-      return false;
+    case EValueKind::kBoolean:
+      if (!value.isBool()) {
+        context.report(concat("JSON value for bool property is not a JSON bool (", property,
+                              "): ", value));
+        return false;
+      }
+      return true;
+    case EValueKind::kInteger:
+      if (!value.isInt()) {
+        context.report(concat("JSON value for integer property is not a JSON integer (", property,
+                              "): ", value));
+        return false;
+      }
+      if ((property.minValue && value.asInt64() < property.minValue.value) ||
+          (property.maxValue && value.asInt64() > property.maxValue.value)) {
+        context.report(concat("JSON integer exceeds bounds (", property, "): ", value));
+        return false;
+      }
+      return true;
+    case EValueKind::kNumber:
+      if (!value.isNumeric()) {
+        context.report(concat("JSON value for number property is not a JSON number (", property,
+                              "): ", value));
+        return false;
+      }
+      return true;
+    case EValueKind::kUuid: {
+      if (!value.isString()) {
+        context.report(concat("JSON value for string property is not a JSON string (", property,
+                              "): ", value));
+        return false;
+      }
+      const char* begin = nullptr;
+      const char* end = nullptr;
+      value.getString(&begin, &end);
+      auto size = static_cast<std::size_t>(end - begin);
+      if (!validateLength(size, UUID_LENGTH, UUID_LENGTH)) {
+        context.report(concat("JSON string length of ", size, "' exceeds bounds (", property,
+                              "): ", value));
+        return false;
+      }
+      if (!validateUuid(begin, end)) {
+        context.report(concat("JSON string is not a valid UUID (", property, "): ", value));
+        return false;
+      }
+      return true;
     }
-    if (!validateLength(value.asString().size(), property.minLength, property.maxLength)) {
-      std::cerr << "JSON string length of " << value.asString().size() << "' exceeds bounds ("
-                << property << "): " << value << std::endl;
+    case EValueKind::kString:
+      if (!value.isString()) {
+        context.report(concat("JSON value for string property is not a JSON string (", property,
+                              "): ", value));
+        return false;
+      }
+      if (!validateLength(getStringSize(value), property.minLength, property.maxLength)) {
+        context.report(concat("JSON string length of ", getStringSize(value),
+                              "' exceeds bounds (", property, "): ", value));
+        return false;
+      }
+      return true;
+    case EValueKind::kSchema:
+      return validateObject(value, m_compiledSchemas[node.target], context);
+    case EValueKind::kUnhandled:
+    default:
+      context.report(concat("Unhandled property (", property, "): ", value));
       return false;
-    }
-    return true;
-  } else if (schemas.find(property.type) != schemas.end()) {
-    return validateSchema(value, schemas.at(property.type), schemas);
-  } else {
-    std::cerr << "Unhandled property (" << property << "): " << value << std::endl;
-    return false;
   }
 }
 
-static bool validateSchema(const Json::Value& value, const SSchema& schema,
-                           const std::map<std::string, SSchema>& schemas) {
-  if (schema.properties.size() > 1 && !value.isObject()) {
-    std::cerr << "JSON for schema '" << schema.id << "' is not an object!" << std::endl;
-    return false;
+bool CSchemaValidator::validateObject(const Json::Value& value, const SCompiledSchema& compiled,
+                                      SContext& context) const {
+  const auto& schema = *compiled.schema;
+  if (compiled.isTopLevelProperty) {
+    return validateNode(value, m_nodes[compiled.propertyNodes.front()], context);
   }
-
-  if (schema.properties.size() == 1 && schema.properties.front().name == TOP_LEVEL_PROPERTY) {
-    return validateProperty(value, schema.properties.front(), schemas);
+  if (!value.isObject() && (schema.properties.size() > 1 || !value.isNull())) {
+    context.report(concat("JSON for schema '", schema.id, "' is not an object!"));
+    return false;
   }
 
-  auto presentMembers = value.getMemberNames();
-  for (const auto& prop : schema.properties) {
-    auto memberIt = std::find(presentMembers.begin(), presentMembers.end(), prop.name);
-    if (prop.required && memberIt == presentMembers.end()) {
-      std::cerr << "Required member for schema '" << schema.id
-                << "' not present in JSON object: " << prop << std::endl;
-      return false;
-    } else if (memberIt != presentMembers.end()) {
-      presentMembers.erase(memberIt);
-
-      if (!validateProperty(value[prop.name], prop, schemas)) {
+  // Look up the schema properties in the (sorted) object members instead of the other way around,
+  // additional members are detected by the number of matched members
+  bool isValid = true;
+  std::size_t numMatchedMembers = 0;
+  for (std::size_t i = 0; i < schema.properties.size(); ++i) {
+    const auto& prop = schema.properties[i];
+    const auto* member = value.find(prop.name.data(), prop.name.data() + prop.name.size());
+    if (!member) {
+      if (prop.required) {
+        context.report(concat("Required member for schema '", schema.id,
+                              "' not present in JSON object: ", prop));
+        isValid = false;
+        if (!context.isCollecting()) {
+          return false;
+        }
+      }
+      continue;
+    }
+    ++numMatchedMembers;
+    CPointerToken token{context.pointer, context.isCollecting(), prop.name};
+    if (!validateNode(*member, m_nodes[compiled.propertyNodes[i]], context)) {
+      isValid = false;
+      if (!context.isCollecting()) {
         return false;
       }
     }
   }
 
-  if (!presentMembers.empty()) {
-    std::cerr << "Additional members in JSON object for schema '" << schema.id << "': ";
-    for (const auto& member : presentMembers) {
-      std::cerr << ' ' << member << ',';
+  if (numMatchedMembers != value.size()) {
+    std::string additionalMembers;
+    for (const auto& member : value.getMemberNames()) {
+      auto isKnown = std::any_of(schema.properties.begin(), schema.properties.end(),
+                                 [&member](const SProperty& prop) { return prop.name == member; });
+      if (!isKnown) {
+        additionalMembers += ' ' + member + ',';
+      }
     }
-    std::cerr << std::endl;
+    context.report(concat("Additional members in JSON object for schema '", schema.id,
+                          "': ", additionalMembers));
     return false;
   }
-  return true;
+  return isValid;
+}
+
+bool CSchemaValidator::validate(const Json::Value& value) const {
+  SContext context{nullptr, std::string{}};
+  return validateObject(value, m_compiledSchemas[m_root], context);
+}
+
+bool CSchemaValidator::validate(const Json::Value& value,
+                                std::vector<SValidationError>& outErrors) const {
+  SContext context{&outErrors, std::string{}};
+  return validateObject(value, m_compiledSchemas[m_root], context);
 }
 
 bool SSchemas::validate(const Json::Value& value) const {
-  return validateSchema(value, root, schemas);
+  return CSchemaValidator{*this}.validate(value);
 }
 
 Json::Value readJsonFile(const std::string& file) {
@@ -153,6 +153,83 @@ struct SSchemas {
   bool validate(const Json::Value& value) const;
 };
 
+/*!
+ * Single schema violation found by CSchemaValidator#validate().
+ */
+struct SValidationError {
+  // JSON Pointer (RFC 6901) of the violating value, empty for the root value
+  std::string pointer;
+  std::string message;
+};
+
+/*!
+ * Validation program compiled once from parsed JSON Schemas.
+ *
+ * All type names and schema references are resolved into indices during construction, so that the
+ * validation of a JSON value neither compares type names nor looks up or copies schema data. Use
+ * this instead of SSchemas#validate() to validate many JSON values against the same schemas.
+ *
+ * NOTE: The given schemas need to outlive the validator!
+ */
+class CSchemaValidator {
+ public:
+  explicit CSchemaValidator(const SSchemas& schemas);
+
+  /*!
+   * Validate the given root JSON value, same as SSchemas#validate(). The first error is printed to
+   * std::cerr.
+   */
+  bool validate(const Json::Value& value) const;
+
+  /*!
+   * Validate the given root JSON value and append all errors to the given output instead of
+   * stopping at the first one. Nothing is printed, so that this may be called concurrently.
+   */
+  bool validate(const Json::Value& value, std::vector<SValidationError>& outErrors) const;
+
+ private:
+  enum class EValueKind : std::uint8_t {
+    kArray,
+    kBoolean,
+    kInteger,
+    kNumber,
+    kUuid,
+    kString,
+    kSchema,
+    kUnhandled,
+  };
+
+  struct SNode {
+    EValueKind kind;
+    // Index of the item node (kArray) or of the compiled schema (kSchema)
+    std::size_t target;
+    // Property with the resolved type, for the bounds and the error messages
+    SProperty property;
+  };
+
+  struct SCompiledSchema {
+    const SSchema* schema;
+    // Node index for each entry in SSchema#properties
+    std::vector<std::size_t> propertyNodes;
+    bool isTopLevelProperty;
+  };
+
+  struct SContext;
+
+  std::size_t compileNode(const std::string& type, const SProperty& property);
+  std::size_t compileSchema(const SSchema& schema);
+
+  bool validateNode(const Json::Value& value, const SNode& node, SContext& context) const;
+  bool validateObject(const Json::Value& value, const SCompiledSchema& compiled,
+                      SContext& context) const;
+
+  const SSchemas& m_schemas;
+  std::map<std::string, std::size_t> m_schemaIndices;
+  std::vector<SNode> m_nodes;
+  std::vector<SCompiledSchema> m_compiledSchemas;
+  std::size_t m_root;
+};
+
 SSchemas parseSchemas(const std::vector<std::string>& files);
 SSchemas parseSchemas(int num_args, char** args);
 
@@ -0,0 +1,397 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#include "stream_helper.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+const char* const STREAM_OPTIONS_USAGE =
+    "  --stream nul|length  Serve NUL-delimited or length-prefixed documents on stdin / stdout\n"
+    "  --socket <path>      Serve the documents on the given local UNIX socket instead\n";
+
+namespace {
+
+/*!
+ * Bidirectional byte stream a session is served on.
+ */
+struct SChannel {
+  // Reads up to the given number of bytes, returns 0 at the end of the input
+  std::function<std::size_t(char* data, std::size_t size)> read;
+  // Writes all given bytes, returns false on failure
+  std::function<bool(const char* data, std::size_t size)> write;
+};
+
+class CFrameReader {
+ public:
+  CFrameReader(EFraming framing, const SChannel& channel)
+      : m_framing(framing), m_channel(channel) {}
+
+  /*!
+   * Reads the next document, returns false at the end of the input or if the input is invalid.
+   */
+  bool next(std::string& document) {
+    if (m_framing == EFraming::kLengthPrefixed) {
+      if (!ensureAvailable(4)) {
+        return false;
+      }
+      const auto* header = reinterpret_cast<const unsigned char*>(m_buffer.data() + m_begin);
+      const std::size_t size = (static_cast<std::uint32_t>(header[0]) << 24) |
+                               (static_cast<std::uint32_t>(header[1]) << 16) |
+                               (static_cast<std::uint32_t>(header[2]) << 8) |
+                               static_cast<std::uint32_t>(header[3]);
+      if (size > MAX_DOCUMENT_SIZE) {
+        // the stream cannot be resynchronized after an invalid length
+        std::cerr << "Document of " << size << " bytes exceeds the maximum of "
+                  << MAX_DOCUMENT_SIZE << " bytes" << std::endl;
+        m_isInvalid = true;
+        return false;
+      }
+      if (!ensureAvailable(4 + size)) {
+        std::cerr << "Input ended within a document" << std::endl;
+        m_isInvalid = true;
+        return false;
+      }
+      document.assign(m_buffer, m_begin + 4, size);
+      m_begin += 4 + size;
+      return true;
+    }
+
+    // number of bytes after the begin of the document which are known to contain no delimiter
+    std::size_t numScanned = 0;
+    while (true) {
+      const auto end = m_buffer.find('\0', m_begin + numScanned);
+      if (end != std::string::npos) {
+        document.assign(m_buffer, m_begin, end - m_begin);
+        m_begin = end + 1;
+        return true;
+      }
+      numScanned = m_buffer.size() - m_begin;
+      if (numScanned > MAX_DOCUMENT_SIZE) {
+        std::cerr << "Document exceeds the maximum of " << MAX_DOCUMENT_SIZE << " bytes"
+                  << std::endl;
+        m_isInvalid = true;
+        return false;
+      }
+      if (!fill()) {
+        // treat an unterminated trailing document as the last one
+        if (m_buffer.size() > m_begin) {
+          document.assign(m_buffer, m_begin, std::string::npos);
+          m_begin = m_buffer.size();
+          return true;
+        }
+        return false;
+      }
+    }
+  }
+
+  /*!
+   * Returns whether reading stopped due to invalid input instead of the end of the input.
+   */
+  bool isInvalid() const { return m_isInvalid; }
+
+ private:
+  bool ensureAvailable(std::size_t size) {
+    while (m_buffer.size() - m_begin < size) {
+      if (!fill()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool fill() {
+    // drop the already consumed documents before reading more data
+    m_buffer.erase(0, m_begin);
+    m_begin = 0;
+
+    const auto oldSize = m_buffer.size();
+    m_buffer.resize(oldSize + READ_SIZE);
+    const auto numRead = m_channel.read(&m_buffer[oldSize], READ_SIZE);
+    m_buffer.resize(oldSize + numRead);
+    return numRead > 0;
+  }
+
+  static constexpr std::size_t READ_SIZE = 64 * 1024;
+  // Limits the buffered input, e.g. for a corrupted length prefix
+  static constexpr std::size_t MAX_DOCUMENT_SIZE = 256 * 1024 * 1024;
+
+  const EFraming m_framing;
+  const SChannel& m_channel;
+  std::string m_buffer;
+  std::size_t m_begin = 0;
+  bool m_isInvalid = false;
+};
+
+constexpr std::size_t CFrameReader::READ_SIZE;
+constexpr std::size_t CFrameReader::MAX_DOCUMENT_SIZE;
+
+#ifndef _WIN32
+/*!
+ * Reads the bytes available on the given file descriptor, waiting only until at least one byte is
+ * available. Returns 0 at the end of the input or on failure.
+ */
+std::size_t readAvailable(int fd, char* data, std::size_t size) {
+  ssize_t numRead;
+  do {
+    numRead = ::read(fd, data, size);
+  } while (numRead < 0 && errno == EINTR);
+  return numRead > 0 ? static_cast<std::size_t>(numRead) : 0;
+}
+#endif
+
+bool writeFrame(EFraming framing, const SChannel& channel, const std::string& document) {
+  if (framing == EFraming::kLengthPrefixed) {
+    const auto size = static_cast<std::uint32_t>(document.size());
+    const char header[4] = {static_cast<char>((size >> 24) & 0xFF),
+                            static_cast<char>((size >> 16) & 0xFF),
+                            static_cast<char>((size >> 8) & 0xFF), static_cast<char>(size & 0xFF)};
+    return channel.write(header, sizeof(header)) &&
+           channel.write(document.data(), document.size());
+  }
+
+  const char delimiter = '\0';
+  return channel.write(document.data(), document.size()) && channel.write(&delimiter, 1);
+}
+
+bool serveSession(EFraming framing, const SChannel& channel, const SessionFactory& createSession) {
+  auto handler = createSession();
+  CFrameReader reader{framing, channel};
+
+  std::string document;
+  while (reader.next(document)) {
+    std::string result;
+    try {
+      result = handler(document);
+    } catch (const std::exception& e) {
+      std::cerr << "Failed to translate document: " << e.what() << std::endl;
+    }
+
+    if (!writeFrame(framing, channel, result)) {
+      return false;
+    }
+  }
+  return !reader.isInvalid();
+}
+
+int serveStdin(EFraming framing, const SessionFactory& createSession) {
+#ifdef _WIN32
+  _setmode(_fileno(stdin), _O_BINARY);
+  _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+  // Read without the buffering of stdin, which would wait for a full buffer, so that each document
+  // is handled as soon as it was received completely
+  SChannel channel{};
+#ifdef _WIN32
+  channel.read = [](char* data, std::size_t size) -> std::size_t {
+    const int numRead = _read(_fileno(stdin), data, static_cast<unsigned int>(size));
+    return numRead > 0 ? static_cast<std::size_t>(numRead) : 0;
+  };
+#else
+  channel.read = [](char* data, std::size_t size) {
+    return readAvailable(STDIN_FILENO, data, size);
+  };
+#endif
+  channel.write = [](const char* data, std::size_t size) {
+    // flush after each write to not delay the responses of interactive clients
+    return std::fwrite(data, 1, size, stdout) == size && std::fflush(stdout) == 0;
+  };
+
+  return serveSession(framing, channel, createSession) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#ifndef _WIN32
+int serveSocket(EFraming framing, const std::string& socketPath,
+                const SessionFactory& createSession) {
+  sockaddr_un address{};
+  if (socketPath.size() >= sizeof(address.sun_path)) {
+    std::cerr << "Socket path is too long: " << socketPath << std::endl;
+    return EXIT_FAILURE;
+  }
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+  const int server = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server < 0) {
+    std::cerr << "Failed to create socket: " << std::strerror(errno) << std::endl;
+    return EXIT_FAILURE;
+  }
+  ::unlink(socketPath.c_str());
+  if (::bind(server, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+      ::listen(server, SOMAXCONN) != 0) {
+    std::cerr << "Failed to listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+    ::close(server);
+    return EXIT_FAILURE;
+  }
+
+  // Disconnecting clients must not terminate the service
+  std::signal(SIGPIPE, SIG_IGN);
+
+  int connection;
+  while ((connection = ::accept(server, nullptr, nullptr)) >= 0 || errno == EINTR) {
+    if (connection < 0) {
+      continue;
+    }
+
+    SChannel channel{};
+    channel.read = [connection](char* data, std::size_t size) {
+      return readAvailable(connection, data, size);
+    };
+    channel.write = [connection](const char* data, std::size_t size) {
+      while (size > 0) {
+        const auto numWritten = ::write(connection, data, size);
+        if (numWritten < 0 && errno == EINTR) {
+          continue;
+        }
+        if (numWritten <= 0) {
+          return false;
+        }
+        data += numWritten;
+        size -= static_cast<std::size_t>(numWritten);
+      }
+      return true;
+    };
+
+    serveSession(framing, channel, createSession);
+    ::close(connection);
+  }
+
+  std::cerr << "Failed to accept connection: " << std::strerror(errno) << std::endl;
+  ::close(server);
+  ::unlink(socketPath.c_str());
+  return EXIT_FAILURE;
+}
+#endif
+
+}  // namespace
+
+int parseStreamOption(int index, int argc, char** argv, SStreamOptions& options) {
+  const std::string option{argv[index]};
+  if (option != "--stream" && option != "--socket") {
+    return 0;
+  }
+  if (index + 1 >= argc) {
+    throw std::invalid_argument{"Missing value for option " + option};
+  }
+
+  const std::string value{argv[index + 1]};
+  options.isEnabled = true;
+  if (option == "--socket") {
+    options.socketPath = value;
+  } else if (value == "nul") {
+    options.framing = EFraming::kNulDelimited;
+  } else if (value == "length") {
+    options.framing = EFraming::kLengthPrefixed;
+  } else {
+    throw std::invalid_argument{"Unknown framing: " + value};
+  }
+  return 2;
+}
+
+int runStreamMode(const SStreamOptions& options, const SessionFactory& createSession) {
+  if (options.socketPath.empty()) {
+    return serveStdin(options.framing, createSession);
+  }
+
+#ifdef _WIN32
+  std::cerr << "UNIX sockets are not supported on this platform" << std::endl;
+  return EXIT_FAILURE;
+#else
+  return serveSocket(options.framing, options.socketPath, createSession);
+#endif
+}
@@ -0,0 +1,139 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+/*!
+ * Framing of the documents exchanged in stream mode.
+ */
+enum class EFraming {
+  // Each document is terminated by a NUL character
+  kNulDelimited,
+  // Each document is preceded by its length in bytes as 32 bit unsigned big-endian integer
+  kLengthPrefixed,
+};
+
+struct SStreamOptions {
+  bool isEnabled = false;
+  EFraming framing = EFraming::kNulDelimited;
+  // Path of the local UNIX socket to listen on, stdin / stdout is used if empty
+  std::string socketPath;
+};
+
+/*!
+ * Translates a single input document into the output document, errors are reported via exceptions.
+ */
+using DocumentHandler = std::function<std::string(const std::string& document)>;
+
+/*!
+ * Creates the handler for a new session, which keeps its state (e.g. the translator) across all
+ * documents of the session.
+ */
+using SessionFactory = std::function<DocumentHandler()>;
+
+/*!
+ * Parses the stream mode options "--stream nul|length" and "--socket <path>" at the given argument
+ * index. Returns the number of consumed arguments, 0 if the argument is no stream mode option.
+ */
+int parseStreamOption(int index, int argc, char** argv, SStreamOptions& options);
+
+/*!
+ * Usage description of the stream mode options.
+ */
+extern const char* const STREAM_OPTIONS_USAGE;
+
+/*!
+ * Runs the stream mode: reads the framed documents from stdin, or from each client connecting to
+ * the UNIX socket, and writes the results back with the same framing.
+ *
+ * stdin is served as a single session until the input ends. For the socket one session is created
+ * per connection and the connections are served one after another until the socket fails.
+ *
+ * If a document fails to translate, the error is printed to stderr and an empty document is written
+ * back, to keep the request / response order. Each document is handled as soon as it was received
+ * completely. Documents exceeding 256 MiB or truncated by the end of the input end the session with
+ * an error, since the framing cannot be recovered.
+ */
+int runStreamMode(const SStreamOptions& options, const SessionFactory& createSession);
@@ -82,41 +82,205 @@ amm-info@iis.fraunhofer.de
 
 // Internal headers
 #include "mpeghuitranslator/simple.h"
+#include "mpeghuitranslator/translator.h"
+#include "stream_helper.h"
 
 // External headers
 #include "json/json.h"
 
 // System headers
-#include <array>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 static std::string readFile(const char* fileName) {
-  std::ifstream fis{fileName};
+  std::ifstream fis{fileName, std::ios::binary | std::ios::ate};
   std::string result;
 
-  std::array<char, 4096> buf{};
-  do {
-    fis.read(buf.data(), buf.size());
-    result.append(buf.data(), static_cast<std::size_t>(fis.gcount()));
-  } while (fis);
+  // read the whole file at once instead of growing the string chunk by chunk
+  const auto size = fis.tellg();
+  if (size > 0) {
+    result.resize(static_cast<std::size_t>(size));
+    fis.seekg(0);
+    fis.read(&result[0], size);
+    result.resize(static_cast<std::size_t>(fis.gcount()));
+  }
 
   return result;
 }
 
+static void writeJson(const Json::Value& json, std::ostream& out) {
+  Json::StreamWriterBuilder builder{};
+  builder["indentation"] = "  ";
+  std::unique_ptr<Json::StreamWriter> writer{builder.newStreamWriter()};
+  writer->write(json, &out);
+}
+
+/*!
+ * Result of the translation of a single file in batch mode.
+ */
+struct SBatchResult {
+  bool isDone = false;
+  std::string output;
+  std::string error;
+};
+
+/*!
+ * Translates the given files with the given number of worker threads, each using its own
+ * translator. The workers pick the next file from a shared cursor, so slow files do not stall the
+ * other workers. The output is written in the order of the input files, the number of finished
+ * but not yet written files is limited, so a slow file does not make the others pile up in memory.
+ */
+static int runBatch(const std::vector<const char*>& fileNames, std::size_t numWorkers) {
+  const auto startTime = std::chrono::steady_clock::now();
+
+  // Limit the number of finished but not yet written results
+  const auto maxResultsInFlight = 4 * numWorkers;
+
+  std::vector<SBatchResult> results(fileNames.size());
+  std::atomic<std::size_t> nextFile{0};
+  std::atomic<std::size_t> numBytes{0};
+  std::mutex lock;
+  std::condition_variable resultAvailable;
+  std::condition_variable resultWritten;
+  std::size_t nextResultToWrite = 0;
+
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0; i < numWorkers; ++i) {
+    workers.emplace_back([&]() {
+      mpeghuitranslator::CUiTranslator translator{"eng"};
+      std::size_t index;
+      while ((index = nextFile.fetch_add(1, std::memory_order_relaxed)) < fileNames.size()) {
+        {
+          std::unique_lock<std::mutex> guard{lock};
+          resultWritten.wait(guard,
+                             [&]() { return index < nextResultToWrite + maxResultsInFlight; });
+        }
+
+        SBatchResult result{};
+        try {
+          const auto xml = readFile(fileNames[index]);
+          numBytes.fetch_add(xml.size(), std::memory_order_relaxed);
+
+          std::ostringstream out;
+          writeJson(translator.mpeghInteractivityToJson(xml), out);
+          result.output = out.str();
+        } catch (const std::exception& e) {
+          result.error = e.what();
+        }
+        result.isDone = true;
+
+        {
+          std::lock_guard<std::mutex> guard{lock};
+          results[index] = std::move(result);
+        }
+        resultAvailable.notify_one();
+      }
+    });
+  }
+
+  // Write the results in input order as soon as they are available
+  int exitCode = EXIT_SUCCESS;
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    SBatchResult result{};
+    {
+      std::unique_lock<std::mutex> guard{lock};
+      resultAvailable.wait(guard, [&]() { return results[i].isDone; });
+      result = std::move(results[i]);
+      results[i] = SBatchResult{};
+      nextResultToWrite = i + 1;
+    }
+    resultWritten.notify_all();
+
+    if (result.error.empty()) {
+      std::cout << result.output;
+    } else {
+      std::cerr << fileNames[i] << ": " << result.error << std::endl;
+      exitCode = EXIT_FAILURE;
+    }
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  const auto seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+  std::cerr << "Translated " << fileNames.size() << " files (" << numBytes.load() << " bytes) in "
+            << seconds << " s with " << numWorkers << " workers: "
+            << static_cast<double>(fileNames.size()) / seconds << " files/s, "
+            << static_cast<double>(numBytes.load()) / seconds / 1e6 << " MB/s" << std::endl;
+  return exitCode;
+}
+
+static void printUsage() {
+  std::cout << "Usage: <program> [-j <number of workers, 0 for all cores>] <XML files>... "
+            << std::endl
+            << "       <program> --stream nul|length [--socket <path>]" << std::endl
+            << STREAM_OPTIONS_USAGE;
+}
+
 int main(int argc, char** argv) {
-  if (argc <= 1) {
-    std::cout << "Usage: <program> <XML files>... " << std::endl;
+  std::size_t numWorkers = 0;
+  std::vector<const char*> fileNames;
+  SStreamOptions streamOptions{};
+  for (int i = 1; i < argc; ++i) {
+    int numConsumed = 0;
+    try {
+      numConsumed = parseStreamOption(i, argc, argv, streamOptions);
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << std::endl;
+      printUsage();
+      return EXIT_FAILURE;
+    }
+
+    if (numConsumed > 0) {
+      i += numConsumed - 1;
+    } else if (std::strcmp(argv[i], "-j") == 0) {
+      if (i + 1 >= argc) {
+        printUsage();
+        return EXIT_FAILURE;
+      }
+      numWorkers = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+      if (numWorkers == 0) {
+        numWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+      }
+    } else {
+      fileNames.push_back(argv[i]);
+    }
+  }
+
+  if (streamOptions.isEnabled) {
+    return runStreamMode(streamOptions, []() -> DocumentHandler {
+      auto translator = std::make_shared<mpeghuitranslator::CUiTranslator>("eng");
+      return [translator](const std::string& xml) {
+        std::ostringstream out;
+        writeJson(translator->mpeghInteractivityToJson(xml), out);
+        return out.str();
+      };
+    });
+  }
+
+  if (fileNames.empty()) {
+    printUsage();
     return EXIT_FAILURE;
   }
 
-  for (int i = 1; i < argc; ++i) {
-    auto json = mpeghuitranslator::mpeghInteractivityToJson(readFile(argv[i]));
-    Json::StreamWriterBuilder builder{};
-    builder["indentation"] = "  ";
-    std::unique_ptr<Json::StreamWriter> writer{builder.newStreamWriter()};
-    writer->write(json, &std::cout);
+  if (numWorkers > 0) {
+    return runBatch(fileNames, numWorkers);
+  }
+
+  for (const auto* fileName : fileNames) {
+    writeJson(mpeghuitranslator::mpeghInteractivityToJson(readFile(fileName)), std::cout);
   }
 
   return EXIT_SUCCESS;
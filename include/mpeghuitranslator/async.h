@@ -0,0 +1,224 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#pragma once
+
+// Internal headers
+#include "mpeghuitranslator/translator.h"
+
+// External headers
+#include "json/forwards.h"
+
+// System headers
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace mpeghuitranslator {
+
+// Private implementation object
+struct STranslationPoolPimpl;
+
+/*!
+ * Configuration of a #CTranslationPool.
+ */
+struct STranslationPoolConfig {
+  // Number of worker threads, 0 to use the number of hardware threads
+  std::size_t numThreads = 0;
+  // Maximum number of submitted but not yet started translations across all translators
+  std::size_t maxPendingJobs = 256;
+  // Whether a queued AudioScene translation is dropped when a newer one for the same translator is
+  // submitted before it was started (see CTranslationPool#submitToJson())
+  bool dropSupersededAudioScenes = true;
+};
+
+/*!
+ * Error reported for translations which could not be submitted, since the maximum number of pending
+ * translations of the #CTranslationPool is reached.
+ */
+class CQueueFullError : public std::runtime_error {
+ public:
+  CQueueFullError() : std::runtime_error("Translation queue is full") {}
+};
+
+/*!
+ * Error reported for AudioScene translations which were dropped without being parsed, since a newer
+ * AudioScene XML was submitted for the same translator in the meantime.
+ */
+class CSupersededError : public std::runtime_error {
+ public:
+  CSupersededError() : std::runtime_error("AudioScene was superseded by a newer one") {}
+};
+
+/*!
+ * Bounded pool of worker threads to run the translations of #CUiTranslator objects asynchronously,
+ * e.g. to not block the audio callback thread of the MPEG-H decoder delivering the AudioScene XML.
+ *
+ * Submitting a translation only enqueues it and never blocks. If the maximum number of pending
+ * translations is reached, the submission is rejected instead.
+ *
+ * All translations submitted for the same translator are executed one after another in the order of
+ * submission, translations for different translators run in parallel.
+ *
+ * The callbacks are called on the worker threads, exceptions thrown by them are ignored. Destroying
+ * the pool waits for all pending translations to finish.
+ */
+class CTranslationPool {
+ public:
+  using ToJsonCallback = std::function<void(Json::Value json, std::exception_ptr error)>;
+  using ToXmlCallback =
+      std::function<void(std::vector<std::string> actionEvents, std::exception_ptr error)>;
+
+  explicit CTranslationPool(const STranslationPoolConfig& config = STranslationPoolConfig{});
+  CTranslationPool(const CTranslationPool&) = delete;
+  CTranslationPool(CTranslationPool&&) noexcept = default;
+  ~CTranslationPool() noexcept;
+
+  CTranslationPool& operator=(const CTranslationPool&) = delete;
+  CTranslationPool& operator=(CTranslationPool&&) noexcept = default;
+
+  /*!
+   * Submits the CUiTranslator#mpeghInteractivityToJson() translation of the given AudioScene XML
+   * for the given translator.
+   *
+   * The given callback is called with the result or the error of the translation. Returns false if
+   * the translation was rejected, in which case the callback is never called.
+   *
+   * If the last queued job of the translator is another AudioScene translation which was not
+   * started yet, this one takes its place in the queue and its callback gets a #CSupersededError,
+   * so the replacement never counts against the maxPendingJobs limit. This keeps the latency bound
+   * to the newest AudioScene instead of the backlog, since the output of the replaced translation
+   * would be overwritten anyway. Scene change translations submitted in between are never skipped.
+   * The #CSupersededError is reported on a worker thread in submission order, never from within
+   * this call.
+   */
+  bool submitToJson(const std::shared_ptr<CUiTranslator>& translator, std::string audioSceneXml,
+                    ToJsonCallback callback);
+
+  /*!
+   * Same as above, but provides the result via the returned future.
+   *
+   * If the translation was rejected, the future holds a #CQueueFullError. If it was dropped as
+   * superseded, the future holds a #CSupersededError.
+   */
+  std::future<Json::Value> submitToJson(const std::shared_ptr<CUiTranslator>& translator,
+                                        std::string audioSceneXml);
+
+  /*!
+   * Submits the CUiTranslator#mpeghInteractivityToXml() translation of the given scene changes for
+   * the given translator.
+   *
+   * The given callback is called with the result or the error of the translation. Returns false if
+   * the translation was rejected, in which case the callback is never called.
+   */
+  bool submitToXml(const std::shared_ptr<CUiTranslator>& translator, Json::Value sceneChangesJson,
+                   ToXmlCallback callback);
+
+  /*!
+   * Same as above, but provides the result via the returned future.
+   *
+   * If the translation was rejected, the future holds a #CQueueFullError.
+   */
+  std::future<std::vector<std::string>> submitToXml(
+      const std::shared_ptr<CUiTranslator>& translator, Json::Value sceneChangesJson);
+
+  /*!
+   * Returns the number of submitted translations which are not yet started.
+   */
+  std::size_t getNumPendingJobs() const;
+
+  /*!
+   * Returns the number of AudioScene translations which were dropped as superseded.
+   */
+  std::uint64_t getNumDroppedAudioScenes() const;
+
+ private:
+  std::unique_ptr<STranslationPoolPimpl> m_pimpl;
+};
+
+}  // namespace mpeghuitranslator
@@ -82,6 +82,7 @@ amm-info@iis.fraunhofer.de
 
 #pragma once
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -108,6 +109,89 @@ typedef struct MpeghUiTranslatorStringList {
   size_t numStrings;
 } MpeghUiTranslatorStringList;
 
+/*! Size of the UUID member in #MpeghUiTranslatorActionEvent including the terminating NUL */
+#define MPEGHUITRANSLATOR_UUID_SIZE 37
+/*! Size of the paramText member in #MpeghUiTranslatorActionEvent including the terminating NUL */
+#define MPEGHUITRANSLATOR_PARAM_TEXT_SIZE 16
+
+/*!
+ * Plain representation of a single MPEG-H UI manager ActionEvent.
+ *
+ * The optional parameters are only part of the ActionEvent if the corresponding has* member is
+ * non-zero.
+ */
+typedef struct MpeghUiTranslatorActionEvent {
+  int actionType;
+  /*! NUL-terminated UUID of the AudioScene this ActionEvent applies to */
+  char uuid[MPEGHUITRANSLATOR_UUID_SIZE];
+  int hasParamInt;
+  int paramInt;
+  int hasParamFloat;
+  float paramFloat;
+  int hasParamBool;
+  int paramBool;
+  int hasParamText;
+  /*! NUL-terminated text parameter */
+  char paramText[MPEGHUITRANSLATOR_PARAM_TEXT_SIZE];
+} MpeghUiTranslatorActionEvent;
+
+typedef struct MpeghUiTranslatorActionEventList {
+  MpeghUiTranslatorActionEvent* events;
+  size_t numEvents;
+} MpeghUiTranslatorActionEventList;
+
+/*! Timing of a single processing stage of a translator */
+typedef struct MpeghUiTranslatorStageStatistics {
+  uint64_t numCalls;
+  uint64_t totalNanoseconds;
+  uint64_t maxNanoseconds;
+} MpeghUiTranslatorStageStatistics;
+
+/*!
+ * Statistics of the processing stages of a translator, see STranslatorStatistics in translator.h
+ * for the meaning of the members.
+ */
+typedef struct MpeghUiTranslatorStatistics {
+  MpeghUiTranslatorStageStatistics xmlParse;
+  MpeghUiTranslatorStageStatistics modelBuild;
+  MpeghUiTranslatorStageStatistics jsonCompose;
+  MpeghUiTranslatorStageStatistics serialization;
+  MpeghUiTranslatorStageStatistics changeParse;
+  MpeghUiTranslatorStageStatistics actionEventCompose;
+  MpeghUiTranslatorStageStatistics mutexWait;
+  uint64_t bytesIn;
+  uint64_t bytesOut;
+  uint64_t numEvents;
+} MpeghUiTranslatorStatistics;
+
+/*!
+ * Heap allocations of a single call, see SAllocationReport in allocations.h for the meaning of the
+ * members.
+ */
+typedef struct MpeghUiTranslatorAllocationReport {
+  int isEnabled;
+  uint64_t numAllocations;
+  uint64_t numBytes;
+  uint64_t numXmlAllocations;
+  uint64_t numXmlBytes;
+} MpeghUiTranslatorAllocationReport;
+
+/*!
+ * Current values of an audio element or switch group, see SElementValues in translator.h. The
+ * values of the optional properties are only valid if the corresponding has* member is non-zero.
+ */
+typedef struct MpeghUiTranslatorElementValues {
+  int isAvailable;
+  int hasProminence;
+  float prominence;
+  int hasMuting;
+  int isMuted;
+  int hasAzimuth;
+  float azimuth;
+  int hasElevation;
+  float elevation;
+} MpeghUiTranslatorElementValues;
+
 /*!
  * Simple conversion of the given MPEG-H UI manager AudioScene XML to the proposed JSON format for
  * application standards defined in the json_schema/ project folder.
@@ -132,10 +216,13 @@ MpeghUiTranslatorStatusCode mpeghUiTranslatorToJson(const char* audioSceneXml,
  *
  * If the outActionScenes output parameter is allocated (has a non-zero numStrings member) but
  * cannot hold enough entries, this function returns MPEGHUITRANSLATOR_INSUFFICIENT_SPACE and sets
- * the outActionScenes#numStrings member to the required number of entries.
+ * the outActionScenes#numStrings member to the required number of entries. A display language
+ * change of a call that does not return MPEGHUITRANSLATOR_OK is not applied.
  *
  * NOTE: This function reads and updates the thread-safe INTERNAL GLOBAL STATE shared with calls to
- * #mpeghInteractivityToJson().
+ * #mpeghInteractivityToJson(). Concurrent calls are ordered with respect to the display language:
+ * each call generates its ActionEvents against the display language left by the previously
+ * completed call.
  *
  * NOTE: The output strings are allocated on the heap and need to be freed by the caller! This can
  * be done e.g. by calling mpeghUiTranslatorFreeStrings().
@@ -147,6 +234,311 @@ MpeghUiTranslatorStatusCode mpeghUiTranslatorToXml(const char* sceneChangesJson,
                                                    size_t sceneChangesJsonSize,
                                                    MpeghUiTranslatorStringList* outActionScenes);
 
+/*!
+ * Same as #mpeghUiTranslatorToXml(), but returns the plain ActionEvent values instead of the XML
+ * ActionEvent strings. This allows to pass the ActionEvents to the MPEG-H UI manager without
+ * composing and parsing the XML representation.
+ *
+ * If the outActionEvents output parameter is allocated (has a non-zero numEvents member) but
+ * cannot hold enough entries, this function returns MPEGHUITRANSLATOR_INSUFFICIENT_SPACE and sets
+ * the outActionEvents#numEvents member to the required number of entries.
+ *
+ * NOTE: This function reads and updates the thread-safe INTERNAL GLOBAL STATE shared with calls to
+ * #mpeghUiTranslatorToJson() and #mpeghUiTranslatorToXml().
+ *
+ * NOTE: The output list is allocated on the heap and needs to be freed by the caller! This can be
+ * done e.g. by calling mpeghUiTranslatorFreeActionEvents().
+ */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorToActionEvents(
+    const char* sceneChangesJson, size_t sceneChangesJsonSize,
+    MpeghUiTranslatorActionEventList* outActionEvents);
+
+/*
+ * Typed scene changes
+ *
+ * The following functions generate the XML ActionEvent objects for a single change to the last
+ * AudioScene passed to #mpeghUiTranslatorToJson() without the need to format and parse an
+ * intermediate JSON document. They behave like #mpeghUiTranslatorToXml() called with a JSON
+ * document containing only the given change, i.e. an empty list is returned if the requested value
+ * is already applied and MPEGHUITRANSLATOR_INTERNAL_ERROR is returned for non-existing IDs.
+ *
+ * The outActionEvents output parameter is handled the same as for #mpeghUiTranslatorToXml().
+ *
+ * NOTE: These functions read the thread-safe INTERNAL GLOBAL STATE shared with calls to
+ * #mpeghUiTranslatorToJson() and #mpeghUiTranslatorToXml().
+ */
+
+/*! Selects the Preset with the given ID. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSelectPreset(
+    int presetId, MpeghUiTranslatorStringList* outActionEvents);
+
+/*! Sets the prominence level (in dB) of the audio element with the given ID in the given Preset. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSetElementProminence(
+    int presetId, int elementId, float level, MpeghUiTranslatorStringList* outActionEvents);
+
+/*! Mutes (non-zero) or un-mutes (zero) the audio element with the given ID in the given Preset. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSetElementMuting(
+    int presetId, int elementId, int muted, MpeghUiTranslatorStringList* outActionEvents);
+
+/*!
+ * Sets the azimuth offset (in degree) of the audio element with the given ID in the given Preset.
+ */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSetElementAzimuth(
+    int presetId, int elementId, float offset, MpeghUiTranslatorStringList* outActionEvents);
+
+/*!
+ * Sets the elevation offset (in degree) of the audio element with the given ID in the given Preset.
+ */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSetElementElevation(
+    int presetId, int elementId, float offset, MpeghUiTranslatorStringList* outActionEvents);
+
+/*! Selects the item with the given ID in the switch group with the given ID in the given Preset. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSelectSwitchGroupItem(
+    int presetId, int switchGroupId, int itemId, MpeghUiTranslatorStringList* outActionEvents);
+
+/*! Mutes (non-zero) or un-mutes (zero) the switch group with the given ID in the given Preset. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSetSwitchGroupMuting(
+    int presetId, int switchGroupId, int muted, MpeghUiTranslatorStringList* outActionEvents);
+
+/*!
+ * Copies the statistics of the processing stages of the INTERNAL GLOBAL STATE into the given
+ * output structure. The statistics are always collected and cheap enough to stay enabled.
+ */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetStatistics(
+    MpeghUiTranslatorStatistics* outStatistics);
+
+/*!
+ * Enables (non-zero) or disables (zero, the default) the validation of the scene changes JSON of
+ * the INTERNAL GLOBAL STATE against the JSON Schemas in the json_schema/POST project folder, see
+ * CUiTranslator#setSchemaValidation() in translator.h.
+ *
+ * A violation is reported as MPEGHUITRANSLATOR_INTERNAL_ERROR with a description of the violation
+ * as last error message.
+ */
+void mpeghUiTranslatorSetSchemaValidation(int enabled);
+
+/*!
+ * Copies the heap allocations of the last completed translation call on the calling thread (of the
+ * global-state or the handle-based interface) into the given output structure.
+ *
+ * The allocations are only counted if the library is built with the CMake option
+ * mpeghuitranslator_ENABLE_ALLOCATION_ACCOUNTING, otherwise the isEnabled member is set to zero.
+ * Output lists allocated via malloc() are not included.
+ */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetLastCallAllocations(
+    MpeghUiTranslatorAllocationReport* outReport);
+
+/*!
+ * Copies a compact binary snapshot of the last AudioScene passed to #mpeghUiTranslatorToJson()
+ * into the given output buffer, see CUiTranslator#saveAudioSceneSnapshot() in translator.h. The
+ * outSnapshotBufferSize output parameter is set to zero if there is no AudioScene yet.
+ *
+ * If the output buffer is too small, this function returns MPEGHUITRANSLATOR_INSUFFICIENT_SPACE
+ * and sets the outSnapshotBufferSize output parameter to the number of bytes that would be
+ * required.
+ *
+ * NOTE: This function reads the thread-safe INTERNAL GLOBAL STATE.
+ */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSaveSnapshot(uint8_t* outSnapshotBuffer,
+                                                         size_t* outSnapshotBufferSize);
+
+/*!
+ * Restores the last AudioScene from the given binary snapshot created by
+ * #mpeghUiTranslatorSaveSnapshot(), e.g. directly from a memory mapped file, without waiting for
+ * the AudioScene XML of the MPEG-H decoder. The JSON output behaves the same as for
+ * #mpeghUiTranslatorToJson().
+ *
+ * An invalid snapshot is reported as MPEGHUITRANSLATOR_INTERNAL_ERROR with a description as last
+ * error message.
+ *
+ * NOTE: This function updates the thread-safe INTERNAL GLOBAL STATE.
+ */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorRestoreSnapshot(const void* snapshot,
+                                                            size_t snapshotSize,
+                                                            char* outJsonBuffer,
+                                                            size_t* outJsonBufferSize);
+
+/*
+ * Scene queries
+ *
+ * The following functions read single values of the last AudioScene passed to
+ * #mpeghUiTranslatorToJson() without composing its JSON representation, see the scene queries of
+ * CUiTranslator in translator.h. They run in constant time and do not allocate.
+ *
+ * Audio elements and switch groups are identified by the preset ID and their own ID as for the
+ * typed scene changes above, a non-zero isSwitchGroup argument selects a switch group. Non-existing
+ * entries are reported as MPEGHUITRANSLATOR_INVALID_ARGUMENT.
+ *
+ * NOTE: These functions read the thread-safe INTERNAL GLOBAL STATE shared with calls to
+ * #mpeghUiTranslatorToJson().
+ */
+
+/*! Sets the outPresetId output parameter to the ID of the active Preset, -1 if there is none. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetActivePreset(int* outPresetId);
+
+/*! Copies the current values of the given audio element or switch group into the given output. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetElementValues(
+    int presetId, int elementId, int isSwitchGroup, MpeghUiTranslatorElementValues* outValues);
+
+/*!
+ * Sets the outItemId output parameter to the ID of the active item of the given switch group, -1 if
+ * no item is active.
+ */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetActiveSwitchGroupItem(int presetId,
+                                                                      int switchGroupId,
+                                                                      int* outItemId);
+
+/*!
+ * Copies the label of the given Preset in the given language (NUL-terminated ISO 639-2 3-letter
+ * code) into the given output buffer. The label is not NUL-terminated, its size is written to the
+ * outLabelBufferSize output parameter.
+ *
+ * If the output buffer is too small, this function returns MPEGHUITRANSLATOR_INSUFFICIENT_SPACE
+ * and sets the outLabelBufferSize output parameter to the number of bytes that would be required.
+ */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetPresetLabel(int presetId, const char* langCode,
+                                                            char* outLabelBuffer,
+                                                            size_t* outLabelBufferSize);
+
+/*! Same as #mpeghUiTranslatorGetPresetLabel() for the given audio element or switch group. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetElementLabel(int presetId, int elementId,
+                                                             int isSwitchGroup,
+                                                             const char* langCode,
+                                                             char* outLabelBuffer,
+                                                             size_t* outLabelBufferSize);
+
+/*
+ * Handle-based interface
+ *
+ * The following functions behave the same as their global-state counterparts above, but operate on
+ * an independent translator instance created via #mpeghUiTranslatorCreate(). Calls on different
+ * handles do not share any state and do not synchronize with each other, so that multiple
+ * translators can run in parallel on separate threads.
+ */
+
+/*! Opaque handle of an independent translator instance */
+typedef struct MpeghUiTranslatorInstance* MpeghUiTranslatorHandle;
+
+/*!
+ * Creates a new independent translator instance with the given initial display language hint (an
+ * ISO 639-2 3-letter code).
+ *
+ * Returns NULL if the instance could not be created.
+ *
+ * NOTE: The returned handle needs to be destroyed by the caller via #mpeghUiTranslatorDestroy()!
+ */
+MpeghUiTranslatorHandle mpeghUiTranslatorCreate(const char* initialDisplayLanguageCodeHint);
+
+/*!
+ * Destroys the given translator instance. Passing NULL is allowed and has no effect.
+ */
+void mpeghUiTranslatorDestroy(MpeghUiTranslatorHandle handle);
+
+/*! Same as #mpeghUiTranslatorToJson() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleToJson(MpeghUiTranslatorHandle handle,
+                                                          const char* audioSceneXml,
+                                                          size_t audioSceneXmlSize,
+                                                          char* outJsonBuffer,
+                                                          size_t* outJsonBufferSize);
+
+/*! Same as #mpeghUiTranslatorToXml() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleToXml(
+    MpeghUiTranslatorHandle handle, const char* sceneChangesJson, size_t sceneChangesJsonSize,
+    MpeghUiTranslatorStringList* outActionScenes);
+
+/*! Same as #mpeghUiTranslatorToActionEvents() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleToActionEvents(
+    MpeghUiTranslatorHandle handle, const char* sceneChangesJson, size_t sceneChangesJsonSize,
+    MpeghUiTranslatorActionEventList* outActionEvents);
+
+/*! Same as #mpeghUiTranslatorSelectPreset() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSelectPreset(
+    MpeghUiTranslatorHandle handle, int presetId, MpeghUiTranslatorStringList* outActionEvents);
+
+/*! Same as #mpeghUiTranslatorSetElementProminence() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSetElementProminence(
+    MpeghUiTranslatorHandle handle, int presetId, int elementId, float level,
+    MpeghUiTranslatorStringList* outActionEvents);
+
+/*! Same as #mpeghUiTranslatorSetElementMuting() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSetElementMuting(
+    MpeghUiTranslatorHandle handle, int presetId, int elementId, int muted,
+    MpeghUiTranslatorStringList* outActionEvents);
+
+/*! Same as #mpeghUiTranslatorSetElementAzimuth() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSetElementAzimuth(
+    MpeghUiTranslatorHandle handle, int presetId, int elementId, float offset,
+    MpeghUiTranslatorStringList* outActionEvents);
+
+/*! Same as #mpeghUiTranslatorSetElementElevation() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSetElementElevation(
+    MpeghUiTranslatorHandle handle, int presetId, int elementId, float offset,
+    MpeghUiTranslatorStringList* outActionEvents);
+
+/*! Same as #mpeghUiTranslatorSelectSwitchGroupItem() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSelectSwitchGroupItem(
+    MpeghUiTranslatorHandle handle, int presetId, int switchGroupId, int itemId,
+    MpeghUiTranslatorStringList* outActionEvents);
+
+/*! Same as #mpeghUiTranslatorSetSwitchGroupMuting() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSetSwitchGroupMuting(
+    MpeghUiTranslatorHandle handle, int presetId, int switchGroupId, int muted,
+    MpeghUiTranslatorStringList* outActionEvents);
+
+/*! Same as #mpeghUiTranslatorGetStatistics() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleGetStatistics(
+    MpeghUiTranslatorHandle handle, MpeghUiTranslatorStatistics* outStatistics);
+
+/*! Same as #mpeghUiTranslatorSetSchemaValidation() for the given translator instance. */
+void mpeghUiTranslatorHandleSetSchemaValidation(MpeghUiTranslatorHandle handle, int enabled);
+
+/*! Same as #mpeghUiTranslatorSaveSnapshot() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSaveSnapshot(MpeghUiTranslatorHandle handle,
+                                                               uint8_t* outSnapshotBuffer,
+                                                               size_t* outSnapshotBufferSize);
+
+/*! Same as #mpeghUiTranslatorRestoreSnapshot() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleRestoreSnapshot(MpeghUiTranslatorHandle handle,
+                                                                  const void* snapshot,
+                                                                  size_t snapshotSize,
+                                                                  char* outJsonBuffer,
+                                                                  size_t* outJsonBufferSize);
+
+/*! Same as #mpeghUiTranslatorGetActivePreset() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleGetActivePreset(MpeghUiTranslatorHandle handle,
+                                                                   int* outPresetId);
+
+/*! Same as #mpeghUiTranslatorGetElementValues() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleGetElementValues(
+    MpeghUiTranslatorHandle handle, int presetId, int elementId, int isSwitchGroup,
+    MpeghUiTranslatorElementValues* outValues);
+
+/*! Same as #mpeghUiTranslatorGetActiveSwitchGroupItem() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleGetActiveSwitchGroupItem(
+    MpeghUiTranslatorHandle handle, int presetId, int switchGroupId, int* outItemId);
+
+/*! Same as #mpeghUiTranslatorGetPresetLabel() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleGetPresetLabel(MpeghUiTranslatorHandle handle,
+                                                                  int presetId,
+                                                                  const char* langCode,
+                                                                  char* outLabelBuffer,
+                                                                  size_t* outLabelBufferSize);
+
+/*! Same as #mpeghUiTranslatorGetElementLabel() for the given translator instance. */
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleGetElementLabel(
+    MpeghUiTranslatorHandle handle, int presetId, int elementId, int isSwitchGroup,
+    const char* langCode, char* outLabelBuffer, size_t* outLabelBufferSize);
+
+/*!
+ * Same as #mpeghUiTranslatorLastError() for the given translator instance. The error message of an
+ * MPEGHUITRANSLATOR_INTERNAL_ERROR refers to the last failed call on the given handle.
+ *
+ * NOTE: The returned pointer references memory owned by the translator instance and is only valid
+ * until the next failing call on the same handle or until the handle is destroyed!
+ */
+const char* mpeghUiTranslatorHandleLastError(MpeghUiTranslatorHandle handle,
+                                             MpeghUiTranslatorStatusCode code);
+
 /*!
  * Frees the strings and the #strings member of the given string list via free() and resets the
  * #numStrings member.
@@ -158,6 +550,14 @@ MpeghUiTranslatorStatusCode mpeghUiTranslatorToXml(const char* sceneChangesJson,
  */
 void mpeghUiTranslatorFreeStrings(MpeghUiTranslatorStringList* list);
 
+/*!
+ * Frees the #events member of the given ActionEvent list via free() and resets the #numEvents
+ * member.
+ *
+ * NOTE: The given ActionEvent list pointer itself is not freed!
+ */
+void mpeghUiTranslatorFreeActionEvents(MpeghUiTranslatorActionEventList* list);
+
 /*!
  * Returns a human-readable error message for the given error status code.
  *
@@ -0,0 +1,213 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#pragma once
+
+// Internal headers
+#include "mpeghuitranslator/translator.h"
+
+// External headers
+#include "json/forwards.h"
+
+// System headers
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mpeghuitranslator {
+
+// Private implementation object
+struct SSessionRegistryPimpl;
+
+/*!
+ * Configuration of a #CSessionRegistry.
+ */
+struct SSessionRegistryConfig {
+  // The initial display language hint of newly created sessions
+  std::string initialDisplayLanguageCodeHint = "eng";
+  // Number of independently locked partitions of the session map
+  std::size_t numShards = 64;
+  // Maximum number of sessions, 0 for no limit
+  std::size_t maxSessions = 0;
+  // Maximum estimated memory of all sessions in bytes including the shared AudioScene structures
+  // referenced by them, each counted once (see SSessionRegistryStatistics#memoryBytes), 0 for no
+  // limit
+  std::size_t maxMemoryBytes = 0;
+  // Sessions not used for longer than this duration are evicted, 0 to never evict idle sessions
+  std::chrono::milliseconds maxIdleTime{0};
+};
+
+/*!
+ * Aggregated statistics of all sessions in a #CSessionRegistry.
+ */
+struct SSessionRegistryStatistics {
+  // Number of currently registered sessions
+  std::size_t numSessions;
+  // Estimated memory of all currently registered sessions in bytes, including the shared AudioScene
+  // structures referenced by them, each counted once regardless of other registries sharing it
+  std::size_t memoryBytes;
+  // Estimated memory of the AudioScene structures shared between all translators of the process
+  // (see CUiTranslator#getSharedMemoryUsage()), reported for information only
+  std::size_t sharedMemoryBytes;
+  // Number of sessions in the fullest shard, to judge the distribution of sessions across shards
+  std::size_t maxSessionsPerShard;
+  std::uint64_t numSessionsCreated;
+  std::uint64_t numSessionsRemoved;
+  // Number of sessions evicted to satisfy the maxSessions and maxMemoryBytes limits
+  std::uint64_t numSessionsEvicted;
+  // Number of sessions evicted for exceeding the maxIdleTime
+  std::uint64_t numIdleSessionsEvicted;
+  std::uint64_t numToJsonCalls;
+  std::uint64_t numToXmlCalls;
+};
+
+/*!
+ * Registry of independent #CUiTranslator sessions, e.g. one per receiver in a head-end deployment,
+ * identified by a caller-defined session ID.
+ *
+ * Sessions are created on first use and are distributed over a number of independently locked
+ * shards. The translation itself runs outside of any registry lock, so calls for different sessions
+ * scale across threads.
+ *
+ * If the configured session or memory limits are exceeded, the least recently used sessions are
+ * evicted. The order of eviction is tracked per shard, i.e. the evicted session is the least
+ * recently used one of its shard, but not necessarily of the whole registry.
+ */
+class CSessionRegistry {
+ public:
+  explicit CSessionRegistry(const SSessionRegistryConfig& config = SSessionRegistryConfig{});
+  CSessionRegistry(const CSessionRegistry&) = delete;
+  CSessionRegistry(CSessionRegistry&&) noexcept = default;
+  ~CSessionRegistry() noexcept;
+
+  CSessionRegistry& operator=(const CSessionRegistry&) = delete;
+  CSessionRegistry& operator=(CSessionRegistry&&) noexcept = default;
+
+  /*!
+   * Same as CUiTranslator#mpeghInteractivityToJson() for the session with the given ID.
+   *
+   * The session is created if it does not exist yet.
+   */
+  Json::Value mpeghInteractivityToJson(const std::string& sessionId,
+                                       const std::string& audioSceneXml);
+
+  /*!
+   * Same as CUiTranslator#mpeghInteractivityToXml() for the session with the given ID.
+   *
+   * The session is created if it does not exist yet.
+   */
+  std::vector<std::string> mpeghInteractivityToXml(const std::string& sessionId,
+                                                   const Json::Value& sceneChangesJson);
+
+  /*!
+   * Returns the translator of the session with the given ID, creating the session if it does not
+   * exist yet.
+   *
+   * NOTE: The returned translator stays valid after the session is evicted, but changes to it are
+   * no longer reflected in the registry!
+   */
+  std::shared_ptr<CUiTranslator> getSession(const std::string& sessionId);
+
+  /*!
+   * Removes the session with the given ID, returns whether the session existed.
+   */
+  bool removeSession(const std::string& sessionId);
+
+  /*!
+   * Evicts all sessions which have not been used for longer than the configured maxIdleTime and
+   * returns the number of evicted sessions.
+   */
+  std::size_t evictIdleSessions();
+
+  /*!
+   * Returns the statistics aggregated over all sessions.
+   */
+  SSessionRegistryStatistics getStatistics() const;
+
+ private:
+  std::unique_ptr<SSessionRegistryPimpl> m_pimpl;
+};
+
+}  // namespace mpeghuitranslator
@@ -0,0 +1,178 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#pragma once
+
+// System headers
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace mpeghuitranslator {
+
+/*!
+ * Identifies an audio element or an audio element switch group of an AudioScene.
+ */
+struct SElementRef {
+  // ID of the preset containing the element, -1 for elements defined on the AudioScene level
+  // (version 9 of the AudioScene XML format)
+  int presetId;
+  // ID of the audio element or the switch group
+  int id;
+  bool isSwitchGroup;
+};
+
+/*!
+ * The active preset changed. The IDs are -1 if no preset was or is active.
+ */
+struct SPresetActivationChange {
+  int oldPresetId;
+  int newPresetId;
+};
+
+/*!
+ * The current prominence level of an audio element or switch group changed.
+ */
+struct SProminenceChange {
+  SElementRef element;
+  float oldValue;
+  float newValue;
+};
+
+/*!
+ * The current muting state of an audio element or switch group changed.
+ */
+struct SMutingChange {
+  SElementRef element;
+  bool oldValue;
+  bool newValue;
+};
+
+/*!
+ * The current azimuth and/or elevation of an audio element or switch group changed. Values of
+ * position properties the element does not have are reported as 0.
+ */
+struct SPositionChange {
+  SElementRef element;
+  float oldAzimuth;
+  float newAzimuth;
+  float oldElevation;
+  float newElevation;
+};
+
+/*!
+ * The active audio element of a switch group changed. The IDs are -1 if no item was or is active.
+ */
+struct SSwitchGroupSelectionChange {
+  int presetId;
+  int switchGroupId;
+  int oldItemId;
+  int newItemId;
+};
+
+/*!
+ * The AudioScene configuration changed, i.e. anything except the current values reported by the
+ * other change types.
+ */
+struct SConfigChange {
+  // UUID of the previous AudioScene, empty for the first AudioScene of a translator
+  std::string oldUuid;
+  std::string newUuid;
+  // The presets, audio elements, switch groups or their availability or ranges changed
+  bool isStructureChanged;
+  // The labels (custom descriptions) of any preset, audio element or switch group changed
+  bool isLabelsChanged;
+};
+
+using PresetActivationCallback = std::function<void(const SPresetActivationChange& change)>;
+using ProminenceCallback = std::function<void(const SProminenceChange& change)>;
+using MutingCallback = std::function<void(const SMutingChange& change)>;
+using PositionCallback = std::function<void(const SPositionChange& change)>;
+using SwitchGroupSelectionCallback = std::function<void(const SSwitchGroupSelectionChange& change)>;
+using ConfigChangeCallback = std::function<void(const SConfigChange& change)>;
+
+/*!
+ * Handle of a subscription registered at a #CUiTranslator, 0 is never used as valid handle.
+ */
+using SubscriptionId = std::uint64_t;
+
+}  // namespace mpeghuitranslator
@@ -0,0 +1,177 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#pragma once
+
+// System headers
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace mpeghuitranslator {
+
+// Private implementation objects
+struct STraceRecorderPimpl;
+struct STraceReaderPimpl;
+
+/*!
+ * Kind of translator input stored in a trace record.
+ */
+enum class ETraceInput {
+  // AudioScene XML passed to CUiTranslator#mpeghInteractivityToJson()
+  kAudioSceneXml,
+  // Scene changes JSON passed to CUiTranslator#mpeghInteractivityToXml()
+  kSceneChangesJson,
+  // Display language hint of the translator when the recorder was attached to it (see
+  // CUiTranslator#setTraceRecorder()), which starts a new translator on replay
+  kDisplayLanguage,
+};
+
+/*!
+ * Single translator input of a trace.
+ */
+struct STraceRecord {
+  // Time of the input in microseconds since the start of the recording
+  std::uint64_t timestamp = 0;
+  ETraceInput input = ETraceInput::kAudioSceneXml;
+  std::string data;
+};
+
+/*!
+ * Records the timestamped sequence of inputs of one or more #CUiTranslator objects to reproduce a
+ * session offline, e.g. with the mpeghui_replay tool.
+ *
+ * The trace format is a text header line "MPEGHUI-TRACE 2" followed by one entry per input, each
+ * consisting of the line "<timestamp in us> xml|json|lang <size in bytes>" followed by the input
+ * data and a line break. Version 1 traces only differ by the missing "lang" entries.
+ *
+ * All member functions may be called concurrently.
+ */
+class CTraceRecorder {
+ public:
+  /*!
+   * Starts a recording into the given output stream, which needs to outlive the recorder.
+   */
+  explicit CTraceRecorder(std::ostream& output);
+  CTraceRecorder(const CTraceRecorder&) = delete;
+  ~CTraceRecorder() noexcept;
+
+  CTraceRecorder& operator=(const CTraceRecorder&) = delete;
+
+  /*!
+   * Appends the given input with the current time to the trace.
+   */
+  void record(ETraceInput input, const std::string& data);
+
+ private:
+  std::unique_ptr<STraceRecorderPimpl> m_pimpl;
+};
+
+/*!
+ * Reads the records of a trace written by #CTraceRecorder.
+ */
+class CTraceReader {
+ public:
+  /*!
+   * Reads the trace header from the given input stream, which needs to outlive the reader.
+   *
+   * Throws a std::runtime_error if the input is no trace.
+   */
+  explicit CTraceReader(std::istream& input);
+  CTraceReader(const CTraceReader&) = delete;
+  ~CTraceReader() noexcept;
+
+  CTraceReader& operator=(const CTraceReader&) = delete;
+
+  /*!
+   * Reads the next record into the given object, returns false at the end of the trace.
+   *
+   * Throws a std::runtime_error if the trace is malformed.
+   */
+  bool next(STraceRecord& record);
+
+ private:
+  std::unique_ptr<STraceReaderPimpl> m_pimpl;
+};
+
+}  // namespace mpeghuitranslator
@@ -82,10 +82,15 @@ amm-info@iis.fraunhofer.de
 
 #pragma once
 
+// Internal headers
+#include "mpeghuitranslator/subscription.h"
+
 // External headers
 #include "json/forwards.h"
 
 // System headers
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -95,10 +100,72 @@ namespace mpeghuitranslator {
 // Private implementation object
 struct SUiTranslatorPimpl;
 
+class CTraceRecorder;
+
+/*!
+ * Timing of a single processing stage of a #CUiTranslator.
+ */
+struct SStageStatistics {
+  std::uint64_t numCalls;
+  std::uint64_t totalNanoseconds;
+  std::uint64_t maxNanoseconds;
+};
+
+/*!
+ * Statistics of the processing stages of a #CUiTranslator since its creation or the last reset.
+ */
+struct STranslatorStatistics {
+  // Reading the AudioScene XML document with libxml2 (skipped for already known AudioScenes)
+  SStageStatistics xmlParse;
+  // Building the AudioScene model from the XML document (skipped for already known AudioScenes)
+  SStageStatistics modelBuild;
+  // Composing the JSON value from the AudioScene model
+  SStageStatistics jsonCompose;
+  // Writing the JSON text (C interface only) and the ActionEvent XML strings
+  SStageStatistics serialization;
+  // Reading the scene changes JSON text (C interface only) and parsing the scene changes
+  SStageStatistics changeParse;
+  // Computing the ActionEvents from the scene changes
+  SStageStatistics actionEventCompose;
+  // Waiting for the lock of the translator state
+  SStageStatistics mutexWait;
+  // Size of the AudioScene XML and (C interface only) scene changes JSON inputs
+  std::uint64_t bytesIn;
+  // Size of the ActionEvent XML and (C interface only) JSON text outputs
+  std::uint64_t bytesOut;
+  // Number of ActionEvents generated
+  std::uint64_t numEvents;
+};
+
+/*!
+ * Current values of an audio element or switch group of the "last audio scene". The values of the
+ * optional properties are only valid if the corresponding has* member is true.
+ */
+struct SElementValues {
+  bool isAvailable;
+  bool hasProminence;
+  float prominence;
+  bool hasMuting;
+  bool isMuted;
+  bool hasAzimuth;
+  float azimuth;
+  bool hasElevation;
+  float elevation;
+};
+
 /*!
  * Main object for translation between MPEG-H UI manager AudioScene XML to the proposed JSON format
  * for application standards defined in the json_schema/ project folder as well as JSON to MPEG-H UI
  * manager ActionEvent XML.
+ *
+ * All member functions may be called concurrently. The "last audio scene" state is replaced as a
+ * whole on every call to #mpeghInteractivityToJson(), concurrent calls to
+ * #mpeghInteractivityToXml() use either the previous or the new state, but are never blocked by the
+ * translation of the new AudioScene.
+ *
+ * Concurrent calls to #mpeghInteractivityToXml() are ordered with respect to the display language:
+ * each call generates its ActionEvents against the display language left by the previously
+ * completed call and applies a changed display language before the next call starts.
  */
 class CUiTranslator {
  public:
@@ -135,6 +202,174 @@ class CUiTranslator {
    */
   std::vector<std::string> mpeghInteractivityToXml(const Json::Value& sceneChangesJson);
 
+  /*!
+   * Returns an estimate of the memory in bytes occupied by the internal state of this translator,
+   * including the stored "last audio scene".
+   *
+   * The structure of an AudioScene, i.e. everything except its current values, is shared between
+   * all translators in the process which received a structurally identical AudioScene. The shared
+   * structure of the "last audio scene" is included in full unless includeSharedStructure is false,
+   * so the estimate of a translator does not change when other translators are created or
+   * destroyed. See #getSharedMemoryUsage() for the memory of all shared structures.
+   */
+  std::size_t getMemoryUsage(bool includeSharedStructure = true) const;
+
+  /*!
+   * Returns an estimate of the memory in bytes occupied by the AudioScene structures currently
+   * shared between the translators of the process, including their lookup tables.
+   */
+  static std::size_t getSharedMemoryUsage();
+
+  /*!
+   * Returns a handle to the shared structure of the stored "last audio scene", which compares equal
+   * for all translators sharing this structure, or nullptr if there is no "last audio scene". The
+   * estimated memory of the structure in bytes is written to outMemoryBytes.
+   *
+   * The structure stays allocated as long as the returned handle is held.
+   */
+  std::shared_ptr<const void> getSharedStructure(std::size_t& outMemoryBytes) const;
+
+  /*!
+   * Records all subsequent inputs of this translator with the given recorder (see trace.h), pass
+   * nullptr to stop recording. A recorder may be shared between multiple translators. The current
+   * display language hint is recorded first, so that a replay starts with the same language.
+   */
+  void setTraceRecorder(std::shared_ptr<CTraceRecorder> recorder);
+
+  /*!
+   * Returns the statistics of the processing stages of this translator.
+   *
+   * The statistics are always collected with relaxed atomic counters and do not need to be enabled.
+   * Values read during concurrent calls may be from slightly different points in time.
+   */
+  STranslatorStatistics getStatistics() const;
+
+  /*!
+   * Resets all statistics of this translator to zero.
+   */
+  void resetStatistics();
+
+  /*!
+   * Enables or disables (the default) the validation of the scene changes JSON passed to
+   * mpeghInteractivityToXml() against the JSON Schemas in the json_schema/POST project folder.
+   *
+   * The schemas are compiled into the library at build time and checked while parsing the scene
+   * changes. Additional, unknown members are allowed. The first violation is reported by throwing
+   * an std::invalid_argument exception before any ActionEvent is generated.
+   */
+  void setSchemaValidation(bool isEnabled);
+
+  /*!
+   * Registers a callback for changes of the active preset (see subscription.h).
+   *
+   * After each call to #mpeghInteractivityToJson() which replaced the "last audio scene" with a
+   * different one, the new AudioScene is compared against the previous one and all subscribers of
+   * the affected change types are called with the old and new values. The callbacks are called on
+   * the thread calling #mpeghInteractivityToJson(), before it returns and without holding any lock
+   * of the translator. Exceptions thrown by the callbacks are ignored.
+   *
+   * Returns the ID to pass to #unsubscribe(). The AudioScenes are only compared while there is at
+   * least one subscription.
+   */
+  SubscriptionId subscribePresetActivation(PresetActivationCallback callback);
+
+  /*!
+   * Same as above, for changes of the prominence level of audio elements and switch groups.
+   */
+  SubscriptionId subscribeProminence(ProminenceCallback callback);
+
+  /*!
+   * Same as above, for changes of the muting state of audio elements and switch groups.
+   */
+  SubscriptionId subscribeMuting(MutingCallback callback);
+
+  /*!
+   * Same as above, for changes of the azimuth or elevation of audio elements and switch groups.
+   */
+  SubscriptionId subscribePosition(PositionCallback callback);
+
+  /*!
+   * Same as above, for changes of the active audio element of switch groups.
+   */
+  SubscriptionId subscribeSwitchGroupSelection(SwitchGroupSelectionCallback callback);
+
+  /*!
+   * Same as above, for changes of the AudioScene UUID, structure or labels.
+   */
+  SubscriptionId subscribeConfigChanges(ConfigChangeCallback callback);
+
+  /*!
+   * Removes the subscription with the given ID. Returns false if there is no such subscription.
+   *
+   * A callback which is currently being called may still be called once after this returns.
+   */
+  bool unsubscribe(SubscriptionId id);
+
+  /*!
+   * Returns a compact binary snapshot of the "last audio scene", which is empty if no AudioScene
+   * was translated yet.
+   *
+   * The snapshot is a flat structure referencing its parts by offsets, e.g. to be stored per
+   * service and mapped into memory via mmap() on the next channel change. It is only meant to be
+   * restored by the same build of this library on the same machine.
+   */
+  std::vector<std::uint8_t> saveAudioSceneSnapshot() const;
+
+  /*!
+   * Restores the "last audio scene" from the given binary snapshot created by
+   * #saveAudioSceneSnapshot(), e.g. directly from a memory mapped file, and returns its JSON
+   * representation the same way as #mpeghInteractivityToJson().
+   *
+   * The snapshot is read without parsing any XML and may be released after this call. Subscribers
+   * are notified as for a new AudioScene. Throws an std::invalid_argument exception if the data is
+   * no valid snapshot.
+   */
+  Json::Value restoreAudioSceneSnapshot(const void* data, std::size_t size);
+
+  /*
+   * Scene queries
+   *
+   * The following functions read single values of the "last audio scene" without composing its
+   * JSON representation, e.g. for overlays polling the current state at frame rate. They run in
+   * constant time on lookup tables built once per distinct AudioScene and never block on
+   * concurrent translations.
+   *
+   * Audio elements and switch groups are identified the same way as by the typed scene changes of
+   * the C interface: by the ID of the preset containing them and their own ID. Entries defined on
+   * the AudioScene level (version 9 of the AudioScene XML format) can be queried with preset ID -1
+   * or the ID of the active preset.
+   */
+
+  /*!
+   * Returns the ID of the active preset, -1 if no preset is active or no AudioScene was translated
+   * yet.
+   */
+  int getActivePresetId() const;
+
+  /*!
+   * Reads the current values of the given audio element or switch group into the given output.
+   * Returns false if there is no such entry.
+   */
+  bool getElementValues(const SElementRef& element, SElementValues& outValues) const;
+
+  /*!
+   * Reads the ID of the active item of the given switch group into the given output, -1 if no item
+   * is active. Returns false if there is no such switch group.
+   */
+  bool getActiveSwitchGroupItem(int presetId, int switchGroupId, int& outItemId) const;
+
+  /*!
+   * Reads the label (custom description) of the given preset in the given language (ISO 639-2
+   * 3-letter code) into the given output. Returns false if there is no such label.
+   */
+  bool getPresetLabel(int presetId, const std::string& langCode, std::string& outLabel) const;
+
+  /*!
+   * Same as above, for the label of the given audio element or switch group.
+   */
+  bool getElementLabel(const SElementRef& element, const std::string& langCode,
+                       std::string& outLabel) const;
+
  private:
   std::unique_ptr<SUiTranslatorPimpl> m_pimpl;
 };
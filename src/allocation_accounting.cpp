@@ -0,0 +1,329 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// Internal headers
+#include "mpeghuitranslator/allocations.h"
+#include "allocation_accounting.h"
+
+#ifdef MPEGHUITRANSLATOR_ALLOCATION_ACCOUNTING
+
+// External headers
+#include "libxml/xmlmemory.h"
+
+// System headers
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace mpeghuitranslator {
+
+// Counters of the calling thread. Plain trivially constructible values, since they are accessed
+// from within operator new.
+struct SThreadAllocations {
+  unsigned int scopeDepth;
+  std::uint64_t numAllocations;
+  std::uint64_t numBytes;
+  std::uint64_t numXmlAllocations;
+  std::uint64_t numXmlBytes;
+};
+
+static thread_local SThreadAllocations CURRENT_ALLOCATIONS;
+static thread_local SThreadAllocations LAST_CALL_ALLOCATIONS;
+
+static void countAllocation(std::size_t size) noexcept {
+  if (CURRENT_ALLOCATIONS.scopeDepth > 0) {
+    ++CURRENT_ALLOCATIONS.numAllocations;
+    CURRENT_ALLOCATIONS.numBytes += size;
+  }
+}
+
+static void countXmlAllocation(std::size_t size) noexcept {
+  if (CURRENT_ALLOCATIONS.scopeDepth > 0) {
+    ++CURRENT_ALLOCATIONS.numXmlAllocations;
+    CURRENT_ALLOCATIONS.numXmlBytes += size;
+  }
+}
+
+// The libxml2 allocators do not track the size of the allocated blocks, so that blocks allocated
+// before the installation of the allocators can still be released with them.
+static void* xmlCountingMalloc(std::size_t size) {
+  countXmlAllocation(size);
+  return std::malloc(size);
+}
+
+static void* xmlCountingRealloc(void* block, std::size_t size) {
+  countXmlAllocation(size);
+  return std::realloc(block, size);
+}
+
+static void xmlCountingFree(void* block) { std::free(block); }
+
+static char* xmlCountingStrdup(const char* value) {
+  auto size = std::strlen(value) + 1;
+  countXmlAllocation(size);
+  auto* result = static_cast<char*>(std::malloc(size));
+  if (result) {
+    std::memcpy(result, value, size);
+  }
+  return result;
+}
+
+static bool installXmlAllocators() {
+  return xmlMemSetup(xmlCountingFree, xmlCountingMalloc, xmlCountingRealloc, xmlCountingStrdup) ==
+         0;
+}
+
+// Install the libxml2 allocators during static initialization, before any document is parsed
+static const bool XML_ALLOCATORS_INSTALLED = installXmlAllocators();
+
+CAllocationScope::CAllocationScope() noexcept {
+  if (CURRENT_ALLOCATIONS.scopeDepth++ == 0) {
+    CURRENT_ALLOCATIONS.numAllocations = 0;
+    CURRENT_ALLOCATIONS.numBytes = 0;
+    CURRENT_ALLOCATIONS.numXmlAllocations = 0;
+    CURRENT_ALLOCATIONS.numXmlBytes = 0;
+  }
+}
+
+CAllocationScope::~CAllocationScope() noexcept {
+  if (--CURRENT_ALLOCATIONS.scopeDepth == 0) {
+    LAST_CALL_ALLOCATIONS = CURRENT_ALLOCATIONS;
+  }
+}
+
+SAllocationReport getLastCallAllocations() {
+  SAllocationReport result{};
+  result.isEnabled = XML_ALLOCATORS_INSTALLED;
+  result.numAllocations = LAST_CALL_ALLOCATIONS.numAllocations;
+  result.numBytes = LAST_CALL_ALLOCATIONS.numBytes;
+  result.numXmlAllocations = LAST_CALL_ALLOCATIONS.numXmlAllocations;
+  result.numXmlBytes = LAST_CALL_ALLOCATIONS.numXmlBytes;
+  return result;
+}
+
+}  // namespace mpeghuitranslator
+
+////
+// Replacement of the global allocation functions
+////
+
+// The alignment of the blocks returned by std::malloc()
+static constexpr std::size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+static void* allocateBlock(std::size_t size, std::size_t alignment) noexcept {
+  if (alignment <= DEFAULT_ALIGNMENT) {
+    return std::malloc(size);
+  }
+#ifdef _WIN32
+  return _aligned_malloc(size, alignment);
+#else
+  void* block = nullptr;
+  return posix_memalign(&block, alignment, size) == 0 ? block : nullptr;
+#endif
+}
+
+static void releaseBlock(void* block, std::size_t alignment) noexcept {
+#ifdef _WIN32
+  // over-aligned blocks are not allocated by std::malloc() on this platform
+  if (alignment > DEFAULT_ALIGNMENT) {
+    _aligned_free(block);
+    return;
+  }
+#endif
+  static_cast<void>(alignment);
+  std::free(block);
+}
+
+static void* allocate(std::size_t size, std::size_t alignment = DEFAULT_ALIGNMENT) {
+  mpeghuitranslator::countAllocation(size);
+  if (size == 0) {
+    size = 1;
+  }
+  while (true) {
+    if (auto* block = allocateBlock(size, alignment)) {
+      return block;
+    }
+    auto handler = std::get_new_handler();
+    if (!handler) {
+      throw std::bad_alloc{};
+    }
+    handler();
+  }
+}
+
+static void* allocate(std::size_t size, std::size_t alignment, const std::nothrow_t&) noexcept {
+  try {
+    return allocate(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+
+void* operator new[](std::size_t size) { return allocate(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept {
+  return allocate(size, DEFAULT_ALIGNMENT, tag);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+  return allocate(size, DEFAULT_ALIGNMENT, tag);
+}
+
+void operator delete(void* block) noexcept { releaseBlock(block, DEFAULT_ALIGNMENT); }
+
+void operator delete[](void* block) noexcept { releaseBlock(block, DEFAULT_ALIGNMENT); }
+
+void operator delete(void* block, const std::nothrow_t&) noexcept {
+  releaseBlock(block, DEFAULT_ALIGNMENT);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept {
+  releaseBlock(block, DEFAULT_ALIGNMENT);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void* block, std::size_t) noexcept { releaseBlock(block, DEFAULT_ALIGNMENT); }
+
+void operator delete[](void* block, std::size_t) noexcept {
+  releaseBlock(block, DEFAULT_ALIGNMENT);
+}
+#endif
+
+#ifdef __cpp_aligned_new
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t& tag) noexcept {
+  return allocate(size, static_cast<std::size_t>(alignment), tag);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t& tag) noexcept {
+  return allocate(size, static_cast<std::size_t>(alignment), tag);
+}
+
+void operator delete(void* block, std::align_val_t alignment) noexcept {
+  releaseBlock(block, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* block, std::align_val_t alignment) noexcept {
+  releaseBlock(block, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* block, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  releaseBlock(block, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* block, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  releaseBlock(block, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* block, std::size_t, std::align_val_t alignment) noexcept {
+  releaseBlock(block, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* block, std::size_t, std::align_val_t alignment) noexcept {
+  releaseBlock(block, static_cast<std::size_t>(alignment));
+}
+#endif
+
+#else
+
+namespace mpeghuitranslator {
+
+SAllocationReport getLastCallAllocations() { return SAllocationReport{}; }
+
+}  // namespace mpeghuitranslator
+
+#endif
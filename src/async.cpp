@@ -0,0 +1,338 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// Internal headers
+#include "mpeghuitranslator/async.h"
+
+// External headers
+#include "json/value.h"
+
+// System headers
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace mpeghuitranslator {
+
+struct STranslationJob {
+  // Keeps the translator alive until all of its jobs are finished
+  std::shared_ptr<CUiTranslator> translator;
+  // Whether the job translates an AudioScene XML, which is superseded by any later one
+  bool isAudioScene = false;
+  // Input and callback of an AudioScene translation
+  std::string audioSceneXml;
+  CTranslationPool::ToJsonCallback toJsonCallback;
+  // Callbacks of the AudioScene translations replaced by this one in submission order, which get a
+  // #CSupersededError before this job is executed
+  std::vector<CTranslationPool::ToJsonCallback> supersededCallbacks;
+  // Input and callback of a scene changes translation
+  Json::Value sceneChangesJson;
+  CTranslationPool::ToXmlCallback toXmlCallback;
+};
+
+/*!
+ * Queue of all pending jobs for a single translator, which are executed strictly one after another.
+ */
+struct STranslatorStrand {
+  std::deque<STranslationJob> jobs;
+};
+
+struct STranslationPoolPimpl {
+  explicit STranslationPoolPimpl(const STranslationPoolConfig& config)
+      : maxPendingJobs(std::max<std::size_t>(config.maxPendingJobs, 1)),
+        dropSupersededAudioScenes(config.dropSupersededAudioScenes) {}
+
+  const std::size_t maxPendingJobs;
+  const bool dropSupersededAudioScenes;
+
+  std::mutex lock;
+  std::condition_variable wakeup;
+  std::unordered_map<const CUiTranslator*, STranslatorStrand> strands;
+  // Strands with pending jobs which are currently not processed by any worker
+  std::deque<const CUiTranslator*> readyStrands;
+  std::size_t numPendingJobs = 0;
+  std::uint64_t numDroppedAudioScenes = 0;
+  bool isStopping = false;
+
+  std::vector<std::thread> workers;
+};
+
+/*!
+ * Calls the given callback with the given result, exceptions thrown by the callback are ignored to
+ * not tear down the worker thread.
+ */
+template <typename Callback, typename Result>
+static void invokeCallback(const Callback& callback, Result&& result, std::exception_ptr error) {
+  try {
+    callback(std::forward<Result>(result), error);
+  } catch (...) {
+  }
+}
+
+static void executeJob(STranslationJob& job) {
+  if (!job.isAudioScene) {
+    std::vector<std::string> result{};
+    std::exception_ptr error{};
+    try {
+      result = job.translator->mpeghInteractivityToXml(job.sceneChangesJson);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    invokeCallback(job.toXmlCallback, std::move(result), error);
+    return;
+  }
+
+  for (const auto& callback : job.supersededCallbacks) {
+    invokeCallback(callback, Json::Value{}, std::make_exception_ptr(CSupersededError{}));
+  }
+
+  Json::Value result{};
+  std::exception_ptr error{};
+  try {
+    result = job.translator->mpeghInteractivityToJson(job.audioSceneXml);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  invokeCallback(job.toJsonCallback, std::move(result), error);
+}
+
+static void runWorker(STranslationPoolPimpl& pool) {
+  std::unique_lock<std::mutex> guard{pool.lock};
+  while (true) {
+    pool.wakeup.wait(guard, [&pool]() { return pool.isStopping || !pool.readyStrands.empty(); });
+    if (pool.readyStrands.empty()) {
+      // stopping and all pending jobs are finished or processed by other workers
+      return;
+    }
+
+    const auto* key = pool.readyStrands.front();
+    pool.readyStrands.pop_front();
+    auto& strand = pool.strands.at(key);
+    auto job = std::move(strand.jobs.front());
+    strand.jobs.pop_front();
+    --pool.numPendingJobs;
+
+    guard.unlock();
+    executeJob(job);
+    job = STranslationJob{};
+    guard.lock();
+
+    auto it = pool.strands.find(key);
+    if (it->second.jobs.empty()) {
+      pool.strands.erase(it);
+    } else {
+      // The strand is only re-queued after the previous job finished to keep the order of its jobs
+      pool.readyStrands.push_back(key);
+    }
+  }
+}
+
+static bool enqueue(STranslationPoolPimpl& pool, STranslationJob job) {
+  if (!job.translator) {
+    throw std::invalid_argument{"Cannot submit translation for an empty translator"};
+  }
+
+  std::unique_lock<std::mutex> guard{pool.lock};
+  auto it = pool.strands.find(job.translator.get());
+  if (pool.dropSupersededAudioScenes && job.isAudioScene && it != pool.strands.end() &&
+      !it->second.jobs.empty() && it->second.jobs.back().isAudioScene) {
+    // The last queued job would be immediately overwritten by the new AudioScene, since no scene
+    // changes were submitted in between. Replace its input in place, so the queue does not grow,
+    // and keep its callback to report the #CSupersededError in order on the worker of the strand,
+    // so no callback runs in here.
+    auto& queued = it->second.jobs.back();
+    queued.supersededCallbacks.push_back(std::move(queued.toJsonCallback));
+    queued.audioSceneXml = std::move(job.audioSceneXml);
+    queued.toJsonCallback = std::move(job.toJsonCallback);
+    ++pool.numDroppedAudioScenes;
+    return true;
+  }
+  if (pool.numPendingJobs >= pool.maxPendingJobs) {
+    return false;
+  }
+
+  const auto* translator = job.translator.get();
+  if (it == pool.strands.end()) {
+    // no jobs pending for this translator, so no worker is processing it
+    it = pool.strands.emplace(translator, STranslatorStrand{}).first;
+    pool.readyStrands.push_back(translator);
+    pool.wakeup.notify_one();
+  }
+  it->second.jobs.push_back(std::move(job));
+  ++pool.numPendingJobs;
+  return true;
+}
+
+template <typename Result>
+static std::function<void(Result, std::exception_ptr)> makePromiseCallback(
+    const std::shared_ptr<std::promise<Result>>& promise) {
+  return [promise](Result result, std::exception_ptr error) {
+    if (error) {
+      promise->set_exception(error);
+    } else {
+      promise->set_value(std::move(result));
+    }
+  };
+}
+
+CTranslationPool::CTranslationPool(const STranslationPoolConfig& config)
+    : m_pimpl(new STranslationPoolPimpl(config)) {
+  auto numThreads = config.numThreads;
+  if (numThreads == 0) {
+    numThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  }
+
+  auto& pool = *m_pimpl;
+  for (std::size_t i = 0; i < numThreads; ++i) {
+    pool.workers.emplace_back([&pool]() { runWorker(pool); });
+  }
+}
+
+CTranslationPool::~CTranslationPool() noexcept {
+  if (!m_pimpl) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard{m_pimpl->lock};
+    m_pimpl->isStopping = true;
+  }
+  m_pimpl->wakeup.notify_all();
+  for (auto& worker : m_pimpl->workers) {
+    worker.join();
+  }
+}
+
+bool CTranslationPool::submitToJson(const std::shared_ptr<CUiTranslator>& translator,
+                                    std::string audioSceneXml, ToJsonCallback callback) {
+  STranslationJob job{};
+  job.translator = translator;
+  job.isAudioScene = true;
+  job.audioSceneXml = std::move(audioSceneXml);
+  job.toJsonCallback = std::move(callback);
+  return enqueue(*m_pimpl, std::move(job));
+}
+
+std::future<Json::Value> CTranslationPool::submitToJson(
+    const std::shared_ptr<CUiTranslator>& translator, std::string audioSceneXml) {
+  auto promise = std::make_shared<std::promise<Json::Value>>();
+  auto future = promise->get_future();
+  if (!submitToJson(translator, std::move(audioSceneXml), makePromiseCallback(promise))) {
+    promise->set_exception(std::make_exception_ptr(CQueueFullError{}));
+  }
+  return future;
+}
+
+bool CTranslationPool::submitToXml(const std::shared_ptr<CUiTranslator>& translator,
+                                   Json::Value sceneChangesJson, ToXmlCallback callback) {
+  STranslationJob job{};
+  job.translator = translator;
+  job.sceneChangesJson = std::move(sceneChangesJson);
+  job.toXmlCallback = std::move(callback);
+  return enqueue(*m_pimpl, std::move(job));
+}
+
+std::future<std::vector<std::string>> CTranslationPool::submitToXml(
+    const std::shared_ptr<CUiTranslator>& translator, Json::Value sceneChangesJson) {
+  auto promise = std::make_shared<std::promise<std::vector<std::string>>>();
+  auto future = promise->get_future();
+  if (!submitToXml(translator, std::move(sceneChangesJson), makePromiseCallback(promise))) {
+    promise->set_exception(std::make_exception_ptr(CQueueFullError{}));
+  }
+  return future;
+}
+
+std::size_t CTranslationPool::getNumPendingJobs() const {
+  std::lock_guard<std::mutex> guard{m_pimpl->lock};
+  return m_pimpl->numPendingJobs;
+}
+
+std::uint64_t CTranslationPool::getNumDroppedAudioScenes() const {
+  std::lock_guard<std::mutex> guard{m_pimpl->lock};
+  return m_pimpl->numDroppedAudioScenes;
+}
+
+}  // namespace mpeghuitranslator
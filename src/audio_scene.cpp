@@ -0,0 +1,175 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// Internal headers
+#include "audio_scene.h"
+#include "scene_index.h"
+
+// System headers
+
+namespace mpeghuitranslator {
+
+static std::size_t estimateMemoryUsage(const std::string& value) {
+  // Short strings are stored inline in the std::string object
+  return value.capacity() > sizeof(std::string) ? value.capacity() + 1 : 0;
+}
+
+static std::size_t estimateMemoryUsage(const SCustomDescriptor& descriptor) {
+  std::size_t result = descriptor.description.capacity() * sizeof(SLocalizedString);
+  for (const auto& label : descriptor.description) {
+    result += estimateMemoryUsage(label.langCode) + estimateMemoryUsage(label.value);
+  }
+  return result;
+}
+
+template <typename T>
+static std::size_t estimateMemoryUsage(const std::unique_ptr<T>& value) {
+  return value ? sizeof(T) : 0;
+}
+
+static std::size_t estimateMemoryUsage(const std::unique_ptr<SCustomAudioElementKind>& kind) {
+  if (!kind) {
+    return 0;
+  }
+  return sizeof(SCustomAudioElementKind) + estimateMemoryUsage(*kind) +
+         estimateMemoryUsage(kind->langCode);
+}
+
+static std::size_t estimateMemoryUsage(const std::unique_ptr<SCustomDescriptor>& descriptor) {
+  return descriptor ? sizeof(SCustomDescriptor) + estimateMemoryUsage(*descriptor) : 0;
+}
+
+static std::size_t estimateMemoryUsage(const std::vector<SAudioElement>& elements) {
+  std::size_t result = elements.capacity() * sizeof(SAudioElement);
+  for (const auto& element : elements) {
+    result += estimateMemoryUsage(element.prominence) + estimateMemoryUsage(element.muting) +
+              estimateMemoryUsage(element.azimuth) + estimateMemoryUsage(element.elevation) +
+              estimateMemoryUsage(element.kind) + estimateMemoryUsage(element.customKind);
+  }
+  return result;
+}
+
+static std::size_t estimateMemoryUsage(const std::vector<SAudioElementSwitch>& switchGroups) {
+  std::size_t result = switchGroups.capacity() * sizeof(SAudioElementSwitch);
+  for (const auto& group : switchGroups) {
+    result += estimateMemoryUsage(group.prominence) + estimateMemoryUsage(group.muting) +
+              estimateMemoryUsage(group.azimuth) + estimateMemoryUsage(group.elevation) +
+              estimateMemoryUsage(group.kind) + estimateMemoryUsage(group.customKind);
+    result += group.audioElements.capacity() * sizeof(SAudioElementSwitchItem);
+    for (const auto& item : group.audioElements) {
+      result += estimateMemoryUsage(item.kind) + estimateMemoryUsage(item.customKind);
+    }
+  }
+  return result;
+}
+
+std::size_t estimateMemoryUsage(const SAudioSceneConfig& asi) {
+  std::size_t result = sizeof(SAudioSceneConfig) + estimateMemoryUsage(asi.uuid) +
+                       estimateMemoryUsage(asi.version) +
+                       asi.drcInfo.availableEffects.capacity() * sizeof(uint32_t);
+
+  result += asi.presets.capacity() * sizeof(SPreset);
+  for (const auto& preset : asi.presets) {
+    result += estimateMemoryUsage(preset.kind) + estimateMemoryUsage(preset.customKind) +
+              estimateMemoryUsage(preset.audioElements) + estimateMemoryUsage(preset.switchGroups);
+  }
+
+  if (asi.index) {
+    result += estimateMemoryUsage(*asi.index);
+  }
+  return result + estimateMemoryUsage(asi.audioElements) + estimateMemoryUsage(asi.switchGroups);
+}
+
+std::size_t estimateMemoryUsage(const SAudioSceneValues& values) {
+  return values.values.capacity() * sizeof(float);
+}
+
+int findActivePresetId(const SAudioSceneConfig& asi, const SAudioSceneValues& values) {
+  for (const auto& preset : asi.presets) {
+    if (isActive(values, preset)) {
+      return preset.id;
+    }
+  }
+  return -1;
+}
+
+}  // namespace mpeghuitranslator
@@ -130,12 +130,19 @@ struct SPresetTable : SAbstractTable {
   std::string table = "PresetTable";
 };
 
+/*!
+ * Position of a current value in the SAudioSceneValues of an AudioScene.
+ */
+using SValueSlot = std::uint32_t;
+
 /*!
  * Common values shared across all properties.
  */
 struct SPropertyCommon {
   // Whether a user is allowed to perform interactivity on this property type
   bool isActionAllowed;
+  // Slot of the current value of this property
+  SValueSlot valueSlot;
 };
 
 /*!
@@ -151,7 +158,6 @@ struct SPropertyCommon {
 struct SProminenceLevelProperty : SPropertyCommon {
   float minValue;
   float maxValue;
-  float currentValue;
   float defaultValue;
 };
 
@@ -160,8 +166,7 @@ struct SProminenceLevelProperty : SPropertyCommon {
  * element switch group.
  */
 struct SMutingProperty : SPropertyCommon {
-  // Current muting state, true for muted, false for not muted
-  bool currentValue;
+  // Default muting state, true for muted, false for not muted
   bool defaultValue;
 };
 
@@ -176,7 +181,6 @@ struct SAzimuthProperty : SPropertyCommon {
   float minValue;
   // Leftmost position in degree
   float maxValue;
-  float currentValue;
   float defaultValue;
 };
 
@@ -191,7 +195,6 @@ struct SElevationProperty : SPropertyCommon {
   float minValue;
   // Uppermost position in degree
   float maxValue;
-  float currentValue;
   float defaultValue;
 };
 
@@ -234,7 +237,8 @@ struct SAudioElementSwitchItem {
   std::unique_ptr<SAudioElementKind> kind;
   std::unique_ptr<SCustomAudioElementKind> customKind;
   int id;
-  bool isActive;
+  // Slot of the current value whether this item is the selected one of its switch group
+  SValueSlot isActiveSlot;
   bool isAvailable;
   bool isSelectable = true;
   bool isDefault;
@@ -264,8 +268,8 @@ struct SPreset {
   std::unique_ptr<SCustomDescriptor> customKind;
   // The ID of this preset
   int id;
-  // Whether this preset is currently applied
-  bool isActive;
+  // Slot of the current value whether this preset is currently applied
+  SValueSlot isActiveSlot;
   // Whether this preset is currently available for selection
   bool isAvailable;
   // Whether this preset is the default selected one
@@ -283,11 +287,16 @@ struct SAvailableLanguage {
   SIso639Code langCode;
 };
 
+struct SAudioSceneIndex;
+
+/*!
+ * Structure of an AudioScene, i.e. everything except the current values which change with user
+ * interactivity. The current values are kept separately in a SAudioSceneValues object and are
+ * referenced by the value slots of the structure.
+ */
 struct SAudioSceneConfig {
   SUuid uuid;
   std::string version = "9.0";
-  // Whether the AudioScene changed in the MPEG-H bitstream
-  bool configChanged;
   SDrcInfo drcInfo;
   std::vector<SPreset> presets;
   // NOTE: Only available in version 9 of the AudioScene XML format, version >= 10 contains audio
@@ -296,16 +305,88 @@ struct SAudioSceneConfig {
   // NOTE: Only available in version 9 of the AudioScene XML format, version >= 10 contains switch
   // groups on a per-preset level.
   std::vector<SAudioElementSwitch> switchGroups;
+  // Lookup tables of this config for the scene queries (see scene_index.h), only built for the
+  // shared configs of the translators (see scene_cache.h)
+  std::shared_ptr<const SAudioSceneIndex> index;
 };
 
-SAudioSceneConfig parseAudioScene(xmlNodePtr node);
+/*!
+ * Current values of an AudioScene in the order of the value slots of its structure. Boolean values
+ * are stored as 0 and 1.
+ */
+struct SAudioSceneValues {
+  // Whether the AudioScene changed in the MPEG-H bitstream
+  bool configChanged;
+  std::vector<float> values;
+};
+
+/*!
+ * AudioScene of a translator, consisting of the immutable structure, which is shared between all
+ * translators with a structurally identical AudioScene (see scene_cache.h), and the current values
+ * of this translator.
+ */
+struct SAudioScene {
+  std::shared_ptr<const SAudioSceneConfig> config;
+  SAudioSceneValues values;
+  // ID of the active preset, -1 if none, determined once when the AudioScene is built (see
+  // findActivePresetId())
+  int activePresetId;
+};
+
+/*!
+ * Appends the given current value to the given values and returns its slot.
+ */
+inline SValueSlot addCurrentValue(SAudioSceneValues& values, float value) {
+  values.values.push_back(value);
+  return static_cast<SValueSlot>(values.values.size() - 1);
+}
+
+/*!
+ * Returns the current value of the given property.
+ */
+template <typename T>
+auto getCurrentValue(const SAudioSceneValues& values, const T& property)
+    -> decltype(property.defaultValue) {
+  return static_cast<decltype(property.defaultValue)>(values.values[property.valueSlot]);
+}
+
+/*!
+ * Returns whether the given preset or switch group item is currently active.
+ */
+template <typename T>
+bool isActive(const SAudioSceneValues& values, const T& entry) {
+  return values.values[entry.isActiveSlot] != 0.0f;
+}
+
+/*!
+ * Returns the ID of the currently active preset of the given AudioScene, or -1 if none is active.
+ */
+int findActivePresetId(const SAudioSceneConfig& asi, const SAudioSceneValues& values);
+
+/*!
+ * Parses the structure of the given AudioScene XML node and appends its current values to the
+ * given values.
+ */
+SAudioSceneConfig parseAudioScene(xmlNodePtr node, SAudioSceneValues& outValues);
+
+/*!
+ * Returns an estimate of the memory in bytes occupied by the given AudioScene config, including all
+ * heap allocations owned by it.
+ */
+std::size_t estimateMemoryUsage(const SAudioSceneConfig& asi);
+
+/*!
+ * Returns an estimate of the memory in bytes occupied by the heap allocations of the given values.
+ */
+std::size_t estimateMemoryUsage(const SAudioSceneValues& values);
 
 /*!
  * Composes a JSON object defined by the proposed JSON format for application standards in the
- * json_schema/ project folder from the given AudioScene config.
+ * json_schema/ project folder from the given AudioScene config with the given current values.
  *
  * The displayLanguageHint parameter is written as-is to the output JSON.
  */
-Json::Value composeAudioScene(const SAudioSceneConfig& asi, const SIso639Code& displayLanguageHint);
+Json::Value composeAudioScene(const SAudioSceneConfig& asi, const SAudioSceneValues& values,
+                              const SIso639Code& displayLanguageHint);
 
 }  // namespace mpeghuitranslator
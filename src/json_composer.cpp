@@ -106,10 +106,11 @@ static Json::Value composeLabel(const SLocalizedString& label) {
   return out;
 }
 
-static Json::Value composeProminence(const SProminenceLevelProperty& prominence) {
+static Json::Value composeProminence(const SProminenceLevelProperty& prominence,
+                                     const SAudioSceneValues& values) {
   Json::Value out{};
 
-  out["level"] = prominence.currentValue;
+  out["level"] = getCurrentValue(values, prominence);
   out["min"] = prominence.minValue;
   out["max"] = prominence.maxValue;
   out["default"] = prominence.defaultValue;
@@ -117,19 +118,20 @@ static Json::Value composeProminence(const SProminenceLevelProperty& prominence)
   return out;
 }
 
-static Json::Value composeMuting(const SMutingProperty& muting) {
+static Json::Value composeMuting(const SMutingProperty& muting, const SAudioSceneValues& values) {
   Json::Value out{};
 
-  out["value"] = muting.currentValue;
+  out["value"] = getCurrentValue(values, muting);
   out["default"] = muting.defaultValue;
 
   return out;
 }
 
-static Json::Value composeAzimuth(const SAzimuthProperty& azimuth) {
+static Json::Value composeAzimuth(const SAzimuthProperty& azimuth,
+                                  const SAudioSceneValues& values) {
   Json::Value out{};
 
-  out["offset"] = azimuth.currentValue;
+  out["offset"] = getCurrentValue(values, azimuth);
   out["min"] = azimuth.minValue;
   out["max"] = azimuth.maxValue;
   out["default"] = azimuth.defaultValue;
@@ -137,10 +139,11 @@ static Json::Value composeAzimuth(const SAzimuthProperty& azimuth) {
   return out;
 }
 
-static Json::Value composeElevation(const SElevationProperty& elevation) {
+static Json::Value composeElevation(const SElevationProperty& elevation,
+                                    const SAudioSceneValues& values) {
   Json::Value out{};
 
-  out["offset"] = elevation.currentValue;
+  out["offset"] = getCurrentValue(values, elevation);
   out["min"] = elevation.minValue;
   out["max"] = elevation.maxValue;
   out["default"] = elevation.defaultValue;
@@ -148,7 +151,8 @@ static Json::Value composeElevation(const SElevationProperty& elevation) {
   return out;
 }
 
-static Json::Value composeAudioElement(const SAudioElement& element) {
+static Json::Value composeAudioElement(const SAudioElement& element,
+                                       const SAudioSceneValues& values) {
   Json::Value out{};
 
   out["id"] = element.id;
@@ -167,23 +171,24 @@ static Json::Value composeAudioElement(const SAudioElement& element) {
     out["contentKind"] = element.kind->code;
   }
   if (element.prominence) {
-    out["prominence"] = composeProminence(*element.prominence);
+    out["prominence"] = composeProminence(*element.prominence, values);
   }
   if (element.muting) {
-    out["muting"] = composeMuting(*element.muting);
+    out["muting"] = composeMuting(*element.muting, values);
   }
   if (element.azimuth) {
-    out["azimuth"] = composeAzimuth(*element.azimuth);
+    out["azimuth"] = composeAzimuth(*element.azimuth, values);
   }
   if (element.elevation) {
-    out["elevation"] = composeElevation(*element.elevation);
+    out["elevation"] = composeElevation(*element.elevation, values);
   }
 
   return out;
 }
 
 static Json::Value composeSwitchGroupItem(const SAudioElementSwitchItem& item,
-                                          const SAudioElementSwitch& switchGroup) {
+                                          const SAudioElementSwitch& switchGroup,
+                                          const SAudioSceneValues& values) {
   Json::Value out{};
 
   out["id"] = item.id;
@@ -202,22 +207,23 @@ static Json::Value composeSwitchGroupItem(const SAudioElementSwitchItem& item,
     out["contentKind"] = item.kind->code;
   }
   if (switchGroup.prominence) {
-    out["prominence"] = composeProminence(*switchGroup.prominence);
+    out["prominence"] = composeProminence(*switchGroup.prominence, values);
   }
   if (switchGroup.muting) {
-    out["muting"] = composeMuting(*switchGroup.muting);
+    out["muting"] = composeMuting(*switchGroup.muting, values);
   }
   if (switchGroup.azimuth) {
-    out["azimuth"] = composeAzimuth(*switchGroup.azimuth);
+    out["azimuth"] = composeAzimuth(*switchGroup.azimuth, values);
   }
   if (switchGroup.elevation) {
-    out["elevation"] = composeElevation(*switchGroup.elevation);
+    out["elevation"] = composeElevation(*switchGroup.elevation, values);
   }
 
   return out;
 }
 
-static Json::Value composeSwitchGroup(const SAudioElementSwitch& switchGroup) {
+static Json::Value composeSwitchGroup(const SAudioElementSwitch& switchGroup,
+                                      const SAudioSceneValues& values) {
   Json::Value out{};
 
   out["id"] = switchGroup.id;
@@ -229,7 +235,7 @@ static Json::Value composeSwitchGroup(const SAudioElementSwitch& switchGroup) {
   }
 
   if (switchGroup.muting) {
-    out["muting"] = composeMuting(*switchGroup.muting);
+    out["muting"] = composeMuting(*switchGroup.muting, values);
   }
 
   auto& objects = out["objects"] = makeEmptyArray();
@@ -237,10 +243,10 @@ static Json::Value composeSwitchGroup(const SAudioElementSwitch& switchGroup) {
     if (element.isDefault) {
       out["defaultObject"] = element.id;
     }
-    if (element.isActive) {
+    if (isActive(values, element)) {
       out["activeObject"] = element.id;
     }
-    objects.append(composeSwitchGroupItem(element, switchGroup));
+    objects.append(composeSwitchGroupItem(element, switchGroup, values));
   }
 
   return out;
@@ -248,7 +254,8 @@ static Json::Value composeSwitchGroup(const SAudioElementSwitch& switchGroup) {
 
 static Json::Value composePreset(const SPreset& preset,
                                  const std::vector<SAudioElement>& additionalAudioElements,
-                                 const std::vector<SAudioElementSwitch>& additionalSwitchGroups) {
+                                 const std::vector<SAudioElementSwitch>& additionalSwitchGroups,
+                                 const SAudioSceneValues& values) {
   Json::Value out{};
 
   out["id"] = preset.id;
@@ -264,28 +271,28 @@ static Json::Value composePreset(const SPreset& preset,
     out["contentKind"] = preset.kind->code;
   }
   out["default"] = preset.isDefault;
-  out["active"] = preset.isActive;
+  out["active"] = isActive(values, preset);
 
   auto& objects = out["objects"] = makeEmptyArray();
   for (const auto& audioElement : preset.audioElements) {
-    objects.append(composeAudioElement(audioElement));
+    objects.append(composeAudioElement(audioElement, values));
   }
   for (const auto& audioElement : additionalAudioElements) {
-    objects.append(composeAudioElement(audioElement));
+    objects.append(composeAudioElement(audioElement, values));
   }
 
   auto& switchGroups = out["switchGroups"] = makeEmptyArray();
   for (const auto& switchGroup : preset.switchGroups) {
-    switchGroups.append(composeSwitchGroup(switchGroup));
+    switchGroups.append(composeSwitchGroup(switchGroup, values));
   }
   for (const auto& switchGroup : additionalSwitchGroups) {
-    switchGroups.append(composeSwitchGroup(switchGroup));
+    switchGroups.append(composeSwitchGroup(switchGroup, values));
   }
 
   return out;
 }
 
-Json::Value composeAudioScene(const SAudioSceneConfig& asi,
+Json::Value composeAudioScene(const SAudioSceneConfig& asi, const SAudioSceneValues& values,
                               const SIso639Code& displayLanguageHint) {
   Json::Value out{};
 
@@ -297,10 +304,10 @@ Json::Value composeAudioScene(const SAudioSceneConfig& asi,
     // For AudioScene XML version 9.0, we only have the objects for the current preset and on
     // AudioScene level. For version 10.0 there are no audio objects and switch groups on AudioScene
     // level, but entries for all presets on Preset level.
-    if (preset.isActive) {
-      presets.append(composePreset(preset, asi.audioElements, asi.switchGroups));
+    if (isActive(values, preset)) {
+      presets.append(composePreset(preset, asi.audioElements, asi.switchGroups, values));
     } else {
-      presets.append(composePreset(preset, {}, {}));
+      presets.append(composePreset(preset, {}, {}, values));
     }
   }
 
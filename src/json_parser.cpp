@@ -82,6 +82,7 @@ amm-info@iis.fraunhofer.de
 
 // Internal headers
 #include "scene_changes.h"
+#include "schema_tables.h"
 
 // External headers
 #include "json/json.h"
@@ -90,73 +91,88 @@ amm-info@iis.fraunhofer.de
 
 namespace mpeghuitranslator {
 
-static SAudioElementChanges parseAudioElementChanges(const Json::Value& json) {
+static SAudioElementChanges parseAudioElementChanges(const Json::Value& json,
+                                                     const SSchemaPosition& schema) {
+  schema.validateObject(json);
   SAudioElementChanges elementChanges{};
 
   elementChanges.id = json["id"].asInt();
 
-  if (auto prominence = json["prominence"]["level"]) {
+  if (const auto& prominence = json["prominence"]["level"]) {
     elementChanges.prominence.set(prominence.asDouble());
   }
-  if (auto muting = json["muting"]["value"]) {
+  if (const auto& muting = json["muting"]["value"]) {
     elementChanges.muting.set(muting.asBool());
   }
-  if (auto azimuth = json["azimuth"]["offset"]) {
+  if (const auto& azimuth = json["azimuth"]["offset"]) {
     elementChanges.azimuth.set(azimuth.asDouble());
   }
-  if (auto elevation = json["elevation"]["offset"]) {
+  if (const auto& elevation = json["elevation"]["offset"]) {
     elementChanges.elevation.set(elevation.asDouble());
   }
 
   return elementChanges;
 }
 
-static SSwitchGroupChanges parseSwitchGroupChanges(const Json::Value& json) {
+static SSwitchGroupChanges parseSwitchGroupChanges(const Json::Value& json,
+                                                   const SSchemaPosition& schema) {
+  schema.validateObject(json, {"objects"});
   SSwitchGroupChanges groupChanges{};
 
   groupChanges.id = json["id"].asInt();
 
-  if (auto activeObject = json["activeObject"]) {
+  if (const auto& activeObject = json["activeObject"]) {
     groupChanges.activeObject.set(activeObject.asInt());
   }
-  if (auto muting = json["muting"]["value"]) {
+  if (const auto& muting = json["muting"]["value"]) {
     groupChanges.muting.set(muting.asBool());
   }
 
-  if (auto objects = json["objects"]) {
+  if (const auto& objects = json["objects"]) {
+    auto objectSchema = schema.items("objects");
     for (const auto& object : objects) {
-      groupChanges.audioElements.push_back(parseAudioElementChanges(object));
+      groupChanges.audioElements.push_back(parseAudioElementChanges(object, objectSchema));
     }
   }
 
   return groupChanges;
 }
 
-static SPresetChanges parsePresetChanges(const Json::Value& json) {
+static SPresetChanges parsePresetChanges(const Json::Value& json, const SSchemaPosition& schema) {
+  schema.validateObject(json, {"objects", "switchGroups"});
   SPresetChanges presetChanges{};
 
   presetChanges.id = json["id"].asInt();
 
-  if (auto isActive = json["active"]) {
+  if (const auto& isActive = json["active"]) {
     presetChanges.isActive.set(isActive.asBool());
   }
 
-  if (auto objects = json["objects"]) {
+  if (const auto& objects = json["objects"]) {
+    auto objectSchema = schema.items("objects");
     for (const auto& object : objects) {
-      presetChanges.audioElements.push_back(parseAudioElementChanges(object));
+      presetChanges.audioElements.push_back(parseAudioElementChanges(object, objectSchema));
     }
   }
 
-  if (auto switchGroups = json["switchGroups"]) {
+  if (const auto& switchGroups = json["switchGroups"]) {
+    auto groupSchema = schema.items("switchGroups");
     for (const auto& group : switchGroups) {
-      presetChanges.switchGroups.push_back(parseSwitchGroupChanges(group));
+      presetChanges.switchGroups.push_back(parseSwitchGroupChanges(group, groupSchema));
     }
   }
 
   return presetChanges;
 }
 
-SAudioSceneChanges parseAudioSceneChanges(const Json::Value& json) {
+SAudioSceneChanges parseAudioSceneChanges(const Json::Value& json, bool validateSchema) {
+  // Validate each object while parsing it instead of walking the whole JSON value twice
+  SSchemaPosition schema{};
+  if (validateSchema) {
+    schema = SSchemaPosition{&POST_SCHEMA_TABLE, POST_SCHEMA_TABLE.rootNode};
+  }
+  schema.validateObject(json, {"audioPresets"});
+
   SAudioSceneChanges asiChanges{};
 
   asiChanges.uuid = json["uuid"].asString();
@@ -164,13 +180,14 @@ SAudioSceneChanges parseAudioSceneChanges(const Json::Value& json) {
   // NOTE: As a work-around to support the MPEG-H UI manager v9.0 which only provides labels for the
   // current display language, allow to still set the display language although this is not
   // specified in the new JSON schema.
-  if (auto displayLanguage = json["currentDisplayLanguage"]) {
+  if (const auto& displayLanguage = json["currentDisplayLanguage"]) {
     asiChanges.displayLanguage.set(displayLanguage.asString());
   }
 
-  if (auto presets = json["audioPresets"]) {
+  if (const auto& presets = json["audioPresets"]) {
+    auto presetSchema = schema.items("audioPresets");
     for (const auto& preset : presets) {
-      asiChanges.presets.push_back(parsePresetChanges(preset));
+      asiChanges.presets.push_back(parsePresetChanges(preset, presetSchema));
     }
   }
 
@@ -84,21 +84,33 @@ amm-info@iis.fraunhofer.de
 // buffers
 #define _SCL_SECURE_NO_WARNINGS
 // Internal headers
+#include "mpeghuitranslator/allocations.h"
 #include "mpeghuitranslator/mpeghuitranslator_c.h"
 #include "mpeghuitranslator/simple.h"
+#include "mpeghuitranslator/trace.h"
 #include "mpeghuitranslator/translator.h"
+#include "allocation_accounting.h"
 #include "audio_scene.h"
+#include "probes.h"
+#include "scene_cache.h"
 #include "scene_changes.h"
-#include "xml_helper.h"
+#include "scene_diff.h"
+#include "scene_index.h"
+#include "scene_snapshot.h"
+#include "statistics.h"
 
 // External headers
 #include "json/json.h"
 
 // System headers
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <memory>
 #include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
 
 namespace mpeghuitranslator {
 
@@ -110,160 +122,1601 @@ struct SUiTranslatorPimpl {
   explicit SUiTranslatorPimpl(SIso639Code initialDisplayLanguageCodeHint)
       : displayLanguageHint(initialDisplayLanguageCodeHint) {}
 
+  // Only guards the display language hint. The last audio scene is published as immutable snapshot
+  // via std::atomic_load()/std::atomic_store(), so that the (potentially expensive) composition of
+  // the outputs can run without holding any lock.
   std::mutex lock;
   SIso639Code displayLanguageHint;
-  std::unique_ptr<SAudioSceneConfig> lastAudioScene;
+  std::shared_ptr<const SAudioScene> lastAudioScene;
+  // Optional recorder of the translator inputs, also accessed via std::atomic_load()/_store()
+  std::shared_ptr<CTraceRecorder> traceRecorder;
+  STranslatorCounters counters;
+  // Validate the scene changes JSON against the json_schema/POST schemas while parsing it
+  std::atomic<bool> isSchemaValidationEnabled{false};
+  // Subscribers notified about the differences between consecutive AudioScenes
+  CSubscriptionList subscriptions;
 };
 
+static std::unique_lock<std::mutex> lockState(SUiTranslatorPimpl& state) {
+  MPEGHUITRANSLATOR_PROBE1(lock_start, &state.lock);
+  CStageTimer timer{&state.counters, STAGE_MUTEX_WAIT};
+  std::unique_lock<std::mutex> guard{state.lock};
+  MPEGHUITRANSLATOR_PROBE1(lock_acquired, &state.lock);
+  return guard;
+}
+
+static SIso639Code getDisplayLanguage(SUiTranslatorPimpl& state) {
+  auto guard = lockState(state);
+  return state.displayLanguageHint;
+}
+
+static std::shared_ptr<const SAudioScene> getLastAudioScene(const SUiTranslatorPimpl& state) {
+  return std::atomic_load(&state.lastAudioScene);
+}
+
+/*!
+ * Publishes the given AudioScene as new "last audio scene" snapshot of the given state and notifies
+ * the subscribers.
+ */
+static void publishAudioScene(SUiTranslatorPimpl& state,
+                              const std::shared_ptr<const SAudioScene>& snapshot) {
+  auto previous = std::atomic_exchange(&state.lastAudioScene, snapshot);
+  if (previous != snapshot && !state.subscriptions.isEmpty()) {
+    state.subscriptions.notify(diffAudioScenes(previous.get(), *snapshot));
+  }
+}
+
+/*!
+ * Composes the JSON representation of the given snapshot with the given display language.
+ */
+static Json::Value composeAudioScene(SUiTranslatorPimpl& state, const SAudioScene& snapshot,
+                                     const SIso639Code& displayLanguage) {
+  CStageTimer timer{&state.counters, STAGE_JSON_COMPOSE};
+  const auto& asi = *snapshot.config;
+  MPEGHUITRANSLATOR_PROBE2(compose_audio_scene_start, asi.uuid.c_str(), asi.presets.size());
+  auto result = composeAudioScene(asi, snapshot.values, displayLanguage);
+  MPEGHUITRANSLATOR_PROBE2(compose_audio_scene_done, asi.uuid.c_str(), asi.presets.size());
+  return result;
+}
+
+static bool isSameValues(const SAudioSceneValues& lhs, const SAudioSceneValues& rhs) {
+  return lhs.configChanged == rhs.configChanged && lhs.values == rhs.values;
+}
+
+/*!
+ * Parses the given AudioScene XML and publishes it as new "last audio scene" snapshot of the given
+ * state. Returns the new snapshot, which is the previous one if the AudioScene is unchanged.
+ */
+static std::shared_ptr<const SAudioScene> updateAudioScene(SUiTranslatorPimpl& state,
+                                                           const std::string& audioSceneXml) {
+  // The values are parsed into a scratch block of the calling thread and only copied into a new
+  // snapshot if they changed, so that repeating the same AudioScene does not allocate the snapshot
+  static thread_local SAudioSceneValues values{};
+
+  state.counters.addBytesIn(audioSceneXml.size());
+  MPEGHUITRANSLATOR_PROBE1(parse_audio_scene_start, audioSceneXml.size());
+  auto config = parseSharedAudioScene(audioSceneXml, values, &state.counters);
+  MPEGHUITRANSLATOR_PROBE3(parse_audio_scene_done, audioSceneXml.size(), config->uuid.c_str(),
+                           config->presets.size());
+
+  auto snapshot = getLastAudioScene(state);
+  if (!snapshot || snapshot->config != config || !isSameValues(snapshot->values, values)) {
+    const auto activePresetId = findActivePresetId(*config, values);
+    snapshot = std::make_shared<const SAudioScene>(
+        SAudioScene{std::move(config), values, activePresetId});
+  }
+  publishAudioScene(state, snapshot);
+  return snapshot;
+}
+
+/*!
+ * Parses the given AudioScene XML, publishes it as new "last audio scene" snapshot of the given
+ * state and composes the JSON representation of the new snapshot.
+ */
+static Json::Value translateAudioScene(SUiTranslatorPimpl& state,
+                                       const std::string& audioSceneXml) {
+  auto snapshot = updateAudioScene(state, audioSceneXml);
+  return composeAudioScene(state, *snapshot, getDisplayLanguage(state));
+}
+
+/*!
+ * Restores the given binary AudioScene snapshot, publishes it as new "last audio scene" snapshot
+ * of the given state and composes the JSON representation of the new snapshot.
+ */
+static Json::Value restoreAudioScene(SUiTranslatorPimpl& state, const void* data,
+                                     std::size_t size) {
+  state.counters.addBytesIn(size);
+  auto snapshot = std::make_shared<SAudioScene>();
+  {
+    CStageTimer timer{&state.counters, STAGE_MODEL_BUILD};
+    snapshot->config = internAudioScene(deserializeAudioScene(data, size, snapshot->values));
+    snapshot->activePresetId = findActivePresetId(*snapshot->config, snapshot->values);
+  }
+  publishAudioScene(state, snapshot);
+  return composeAudioScene(state, *snapshot, getDisplayLanguage(state));
+}
+
+/*!
+ * Serializes the "last audio scene" of the given state into the given output, which is left empty
+ * if there is none.
+ */
+static void saveAudioScene(const SUiTranslatorPimpl& state, std::vector<std::uint8_t>& out) {
+  out.clear();
+  if (auto snapshot = getLastAudioScene(state)) {
+    serializeAudioScene(*snapshot, out);
+  }
+}
+
+static SAudioSceneChanges parseSceneChanges(SUiTranslatorPimpl& state,
+                                            const Json::Value& sceneChangesJson) {
+  CStageTimer timer{&state.counters, STAGE_CHANGE_PARSE};
+  MPEGHUITRANSLATOR_PROBE1(parse_scene_changes_start, std::size_t{0});
+  auto changes =
+      parseAudioSceneChanges(sceneChangesJson, state.isSchemaValidationEnabled.load());
+  MPEGHUITRANSLATOR_PROBE3(parse_scene_changes_done, std::size_t{0}, changes.uuid.c_str(),
+                           changes.presets.size());
+  return changes;
+}
+
+/*!
+ * Generates the ActionEvents for the given changes against the given snapshot of the "last audio
+ * scene" and passes them to the given function, which returns whether they were delivered.
+ *
+ * The display language hint of the given state is read, used for the ActionEvents and updated
+ * under one lock of the state, so that concurrent translations of scene changes are ordered: each
+ * one sees the display language left by the previously delivered one. The hint is only updated if
+ * the ActionEvents were delivered, a failed delivery leaves it untouched. The given function must
+ * therefore not lock the state itself.
+ */
+template <typename Deliver>
+static bool translateSceneChanges(SUiTranslatorPimpl& state,
+                                  const std::shared_ptr<const SAudioScene>& snapshot,
+                                  const SAudioSceneChanges& changes, Deliver&& deliver) {
+  auto guard = lockState(state);
+  // reused between calls, so that the strings of the events keep their capacity
+  static thread_local std::vector<SActionEvent> events;
+  {
+    CStageTimer timer{&state.counters, STAGE_ACTION_EVENT_COMPOSE};
+    MPEGHUITRANSLATOR_PROBE2(compose_action_events_start, changes.uuid.c_str(),
+                             changes.presets.size());
+    collectActionEvents(changes, snapshot.get(), &state.displayLanguageHint, events);
+    MPEGHUITRANSLATOR_PROBE3(compose_action_events_done, changes.uuid.c_str(),
+                             changes.presets.size(), events.size());
+  }
+  state.counters.addEvents(events.size());
+
+  if (!deliver(events)) {
+    return false;
+  }
+  if (changes.displayLanguage.isChanged) {
+    state.displayLanguageHint = changes.displayLanguage.newValue;
+  }
+  return true;
+}
+
+/*!
+ * Composes the XML strings of the given ActionEvents into the given output strings. Existing
+ * strings of the output are reused and keep their capacity.
+ */
+static void composeActionEvents(SUiTranslatorPimpl& state, const std::vector<SActionEvent>& events,
+                                std::vector<std::string>& outEvents) {
+  CStageTimer timer{&state.counters, STAGE_SERIALIZATION};
+  MPEGHUITRANSLATOR_PROBE1(serialize_action_events_start, events.size());
+  // Never shrink the output, so that the strings of previous calls remain allocated
+  if (outEvents.size() < events.size()) {
+    outEvents.resize(events.size());
+  }
+  std::size_t numBytes = 0;
+  for (std::size_t i = 0; i < events.size(); ++i) {
+    composeActionEvent(events[i], outEvents[i]);
+    numBytes += outEvents[i].size();
+  }
+  MPEGHUITRANSLATOR_PROBE2(serialize_action_events_done, events.size(), numBytes);
+  state.counters.addBytesOut(numBytes);
+}
+
+/*!
+ * Generates the ActionEvents for the given changes against the "last audio scene" snapshot of the
+ * given state and composes their XML strings.
+ */
+static std::vector<std::string> translateToActionEventXml(SUiTranslatorPimpl& state,
+                                                          const SAudioSceneChanges& changes) {
+  std::vector<std::string> result;
+  translateSceneChanges(state, getLastAudioScene(state), changes,
+                        [&](const std::vector<SActionEvent>& events) {
+                          composeActionEvents(state, events, result);
+                          return true;
+                        });
+  return result;
+}
+
+////
+// Scene queries on the lookup tables of the "last audio scene" snapshot
+////
+
+static int queryActivePreset(const std::shared_ptr<const SAudioScene>& snapshot) {
+  return snapshot ? snapshot->activePresetId : -1;
+}
+
+static std::uint64_t withPresetId(std::uint64_t key, int presetId) {
+  return getEntryKey(presetId, static_cast<int>(key & 0xFFFFFFFFU));
+}
+
+static SLabelKey withPresetId(const SLabelKey& key, int presetId) {
+  return SLabelKey{key.entry, withPresetId(key.id, presetId), key.langCode};
+}
+
+/*!
+ * Returns the value of the given key of the given preset from the given lookup table, or NULL if
+ * there is none. Entries on the AudioScene level are also found with the ID of the active preset.
+ */
+template <typename K, typename V, typename H>
+static const V* findIndexedEntry(const SAudioScene& scene, const std::unordered_map<K, V, H>& table,
+                                 const K& key, int presetId) {
+  auto it = table.find(key);
+  if (it == table.end() && presetId != -1 && presetId == scene.activePresetId) {
+    it = table.find(withPresetId(key, -1));
+  }
+  return it != table.end() ? &it->second : nullptr;
+}
+
+template <typename T>
+static SElementValues toElementValues(const T& element, const SAudioSceneValues& values) {
+  SElementValues result{};
+  result.isAvailable = element.isAvailable;
+  if (element.prominence) {
+    result.hasProminence = true;
+    result.prominence = getCurrentValue(values, *element.prominence);
+  }
+  if (element.muting) {
+    result.hasMuting = true;
+    result.isMuted = getCurrentValue(values, *element.muting);
+  }
+  if (element.azimuth) {
+    result.hasAzimuth = true;
+    result.azimuth = getCurrentValue(values, *element.azimuth);
+  }
+  if (element.elevation) {
+    result.hasElevation = true;
+    result.elevation = getCurrentValue(values, *element.elevation);
+  }
+  return result;
+}
+
+static bool queryElementValues(const std::shared_ptr<const SAudioScene>& snapshot,
+                               const SElementRef& element, SElementValues& outValues) {
+  if (!snapshot) {
+    return false;
+  }
+  const auto& index = *snapshot->config->index;
+  auto key = getEntryKey(element.presetId, element.id);
+  if (element.isSwitchGroup) {
+    const auto* switchGroup =
+        findIndexedEntry(*snapshot, index.switchGroups, key, element.presetId);
+    if (!switchGroup) {
+      return false;
+    }
+    outValues = toElementValues(**switchGroup, snapshot->values);
+  } else {
+    const auto* audioElement =
+        findIndexedEntry(*snapshot, index.audioElements, key, element.presetId);
+    if (!audioElement) {
+      return false;
+    }
+    outValues = toElementValues(**audioElement, snapshot->values);
+  }
+  return true;
+}
+
+static bool queryActiveSwitchGroupItem(const std::shared_ptr<const SAudioScene>& snapshot,
+                                       int presetId, int switchGroupId, int& outItemId) {
+  if (!snapshot) {
+    return false;
+  }
+  const auto* switchGroup =
+      findIndexedEntry(*snapshot, snapshot->config->index->switchGroups,
+                       getEntryKey(presetId, switchGroupId), presetId);
+  if (!switchGroup) {
+    return false;
+  }
+  outItemId = -1;
+  for (const auto& item : (*switchGroup)->audioElements) {
+    if (isActive(snapshot->values, item)) {
+      outItemId = item.id;
+      break;
+    }
+  }
+  return true;
+}
+
+/*!
+ * Returns the label of the given entry, which is only valid as long as the given snapshot is
+ * referenced, or NULL if there is no such label.
+ */
+static const std::string* queryLabel(const std::shared_ptr<const SAudioScene>& snapshot,
+                                     EIndexedEntry entry, int presetId, int id,
+                                     const SLangCode& langCode) {
+  if (!snapshot) {
+    return nullptr;
+  }
+  const auto* label = findIndexedEntry(*snapshot, snapshot->config->index->labels,
+                                       SLabelKey{entry, getEntryKey(presetId, id), langCode},
+                                       presetId);
+  return label ? *label : nullptr;
+}
+
+static EIndexedEntry getIndexedEntry(const SElementRef& element) {
+  return element.isSwitchGroup ? EIndexedEntry::kSwitchGroup : EIndexedEntry::kAudioElement;
+}
+
 CUiTranslator::CUiTranslator(const std::string& initialDisplayLanguageCodeHint)
     : m_pimpl(new SUiTranslatorPimpl(initialDisplayLanguageCodeHint)) {}
 
-CUiTranslator::~CUiTranslator() noexcept = default;
+CUiTranslator::~CUiTranslator() noexcept = default;
+
+Json::Value CUiTranslator::mpeghInteractivityToJson(const std::string& audioSceneXml) {
+  CAllocationScope allocationScope{};
+  if (!m_pimpl) {
+    m_pimpl.reset(new SUiTranslatorPimpl(""));
+  }
+
+  if (auto recorder = std::atomic_load(&m_pimpl->traceRecorder)) {
+    recorder->record(ETraceInput::kAudioSceneXml, audioSceneXml);
+  }
+  return translateAudioScene(*m_pimpl, audioSceneXml);
+}
+
+std::vector<std::string> CUiTranslator::mpeghInteractivityToXml(
+    const Json::Value& sceneChangesJson) {
+  CAllocationScope allocationScope{};
+  if (!m_pimpl) {
+    m_pimpl.reset(new SUiTranslatorPimpl(""));
+  }
+
+  if (auto recorder = std::atomic_load(&m_pimpl->traceRecorder)) {
+    Json::StreamWriterBuilder builder{};
+    builder["indentation"] = "";
+    recorder->record(ETraceInput::kSceneChangesJson, Json::writeString(builder, sceneChangesJson));
+  }
+
+  auto changes = parseSceneChanges(*m_pimpl, sceneChangesJson);
+  return translateToActionEventXml(*m_pimpl, changes);
+}
+
+std::size_t CUiTranslator::getMemoryUsage(bool includeSharedStructure) const {
+  if (!m_pimpl) {
+    return 0;
+  }
+
+  std::size_t result = sizeof(SUiTranslatorPimpl) + getDisplayLanguage(*m_pimpl).capacity();
+  if (auto snapshot = getLastAudioScene(*m_pimpl)) {
+    result += sizeof(SAudioScene) + estimateMemoryUsage(snapshot->values);
+    if (includeSharedStructure) {
+      result += estimateMemoryUsage(*snapshot->config);
+    }
+  }
+  return result;
+}
+
+std::size_t CUiTranslator::getSharedMemoryUsage() { return getSharedAudioSceneMemoryUsage(); }
+
+std::shared_ptr<const void> CUiTranslator::getSharedStructure(std::size_t& outMemoryBytes) const {
+  outMemoryBytes = 0;
+  auto snapshot = m_pimpl ? getLastAudioScene(*m_pimpl) : nullptr;
+  if (!snapshot) {
+    return nullptr;
+  }
+  outMemoryBytes = getSharedAudioSceneMemoryUsage(snapshot->config);
+  return snapshot->config;
+}
+
+void CUiTranslator::setTraceRecorder(std::shared_ptr<CTraceRecorder> recorder) {
+  if (!m_pimpl) {
+    m_pimpl.reset(new SUiTranslatorPimpl(""));
+  }
+
+  if (recorder) {
+    // The ActionEvents depend on the display language, so the replay needs to start with it
+    recorder->record(ETraceInput::kDisplayLanguage, getDisplayLanguage(*m_pimpl));
+  }
+  std::atomic_store(&m_pimpl->traceRecorder, std::move(recorder));
+}
+
+STranslatorStatistics CUiTranslator::getStatistics() const {
+  if (!m_pimpl) {
+    return STranslatorStatistics{};
+  }
+
+  return m_pimpl->counters.load();
+}
+
+void CUiTranslator::resetStatistics() {
+  if (m_pimpl) {
+    m_pimpl->counters.reset();
+  }
+}
+
+void CUiTranslator::setSchemaValidation(bool isEnabled) {
+  if (!m_pimpl) {
+    m_pimpl.reset(new SUiTranslatorPimpl(""));
+  }
+
+  m_pimpl->isSchemaValidationEnabled = isEnabled;
+}
+
+SubscriptionId CUiTranslator::subscribePresetActivation(PresetActivationCallback callback) {
+  if (!m_pimpl) {
+    m_pimpl.reset(new SUiTranslatorPimpl(""));
+  }
+
+  return m_pimpl->subscriptions.add(std::move(callback));
+}
+
+SubscriptionId CUiTranslator::subscribeProminence(ProminenceCallback callback) {
+  if (!m_pimpl) {
+    m_pimpl.reset(new SUiTranslatorPimpl(""));
+  }
+
+  return m_pimpl->subscriptions.add(std::move(callback));
+}
+
+SubscriptionId CUiTranslator::subscribeMuting(MutingCallback callback) {
+  if (!m_pimpl) {
+    m_pimpl.reset(new SUiTranslatorPimpl(""));
+  }
+
+  return m_pimpl->subscriptions.add(std::move(callback));
+}
+
+SubscriptionId CUiTranslator::subscribePosition(PositionCallback callback) {
+  if (!m_pimpl) {
+    m_pimpl.reset(new SUiTranslatorPimpl(""));
+  }
+
+  return m_pimpl->subscriptions.add(std::move(callback));
+}
+
+SubscriptionId CUiTranslator::subscribeSwitchGroupSelection(
+    SwitchGroupSelectionCallback callback) {
+  if (!m_pimpl) {
+    m_pimpl.reset(new SUiTranslatorPimpl(""));
+  }
+
+  return m_pimpl->subscriptions.add(std::move(callback));
+}
+
+SubscriptionId CUiTranslator::subscribeConfigChanges(ConfigChangeCallback callback) {
+  if (!m_pimpl) {
+    m_pimpl.reset(new SUiTranslatorPimpl(""));
+  }
+
+  return m_pimpl->subscriptions.add(std::move(callback));
+}
+
+bool CUiTranslator::unsubscribe(SubscriptionId id) {
+  return m_pimpl && m_pimpl->subscriptions.remove(id);
+}
+
+std::vector<std::uint8_t> CUiTranslator::saveAudioSceneSnapshot() const {
+  CAllocationScope allocationScope{};
+  std::vector<std::uint8_t> result;
+  if (m_pimpl) {
+    saveAudioScene(*m_pimpl, result);
+  }
+  return result;
+}
+
+Json::Value CUiTranslator::restoreAudioSceneSnapshot(const void* data, std::size_t size) {
+  CAllocationScope allocationScope{};
+  if (!m_pimpl) {
+    m_pimpl.reset(new SUiTranslatorPimpl(""));
+  }
+
+  return restoreAudioScene(*m_pimpl, data, size);
+}
+
+int CUiTranslator::getActivePresetId() const {
+  if (!m_pimpl) {
+    return -1;
+  }
+
+  return queryActivePreset(getLastAudioScene(*m_pimpl));
+}
+
+bool CUiTranslator::getElementValues(const SElementRef& element, SElementValues& outValues) const {
+  return m_pimpl && queryElementValues(getLastAudioScene(*m_pimpl), element, outValues);
+}
+
+bool CUiTranslator::getActiveSwitchGroupItem(int presetId, int switchGroupId,
+                                             int& outItemId) const {
+  return m_pimpl && queryActiveSwitchGroupItem(getLastAudioScene(*m_pimpl), presetId,
+                                               switchGroupId, outItemId);
+}
+
+bool CUiTranslator::getPresetLabel(int presetId, const std::string& langCode,
+                                   std::string& outLabel) const {
+  if (!m_pimpl) {
+    return false;
+  }
+
+  SLangCode code{};
+  if (!toLangCode(langCode, code)) {
+    return false;
+  }
+  auto snapshot = getLastAudioScene(*m_pimpl);
+  const auto* label = queryLabel(snapshot, EIndexedEntry::kPreset, -1, presetId, code);
+  if (!label) {
+    return false;
+  }
+  outLabel = *label;
+  return true;
+}
+
+bool CUiTranslator::getElementLabel(const SElementRef& element, const std::string& langCode,
+                                    std::string& outLabel) const {
+  if (!m_pimpl) {
+    return false;
+  }
+
+  SLangCode code{};
+  if (!toLangCode(langCode, code)) {
+    return false;
+  }
+  auto snapshot = getLastAudioScene(*m_pimpl);
+  const auto* label =
+      queryLabel(snapshot, getIndexedEntry(element), element.presetId, element.id, code);
+  if (!label) {
+    return false;
+  }
+  outLabel = *label;
+  return true;
+}
+
+}  // namespace mpeghuitranslator
+
+////
+// Translator instance shared by the global-state and handle-based public C interface
+////
+
+/*!
+ * Scratch buffers of the public C interface. The buffers keep their capacity and their last
+ * results between calls, so that repeated translations of the same inputs do not allocate memory.
+ */
+struct SInstanceBuffers {
+  // AudioScene XML last parsed into the snapshot, so that the parsing is skipped if the same
+  // AudioScene is translated again while the snapshot is still the "last audio scene"
+  std::string audioSceneXml;
+  std::weak_ptr<const mpeghuitranslator::SAudioScene> audioSceneSnapshot;
+  std::string json;
+  // AudioScene snapshot and display language the JSON text was composed from, so that the text is
+  // reused if the same AudioScene is translated again
+  std::weak_ptr<const mpeghuitranslator::SAudioScene> jsonSnapshot;
+  mpeghuitranslator::SIso639Code jsonDisplayLanguage;
+  // Scene changes JSON text last parsed into sceneChanges, with the schema validation setting it
+  // was parsed with
+  std::string sceneChangesJson;
+  bool isSceneChangesValidated = false;
+  mpeghuitranslator::SAudioSceneChanges sceneChanges;
+  std::vector<std::string> actionEvents;
+  std::unique_ptr<Json::CharReader> jsonReader{Json::CharReaderBuilder{}.newCharReader()};
+  std::unique_ptr<Json::StreamWriter> jsonWriter{Json::StreamWriterBuilder{}.newStreamWriter()};
+};
+
+struct MpeghUiTranslatorInstance {
+  explicit MpeghUiTranslatorInstance(const std::string& initialDisplayLanguageCodeHint)
+      : state(initialDisplayLanguageCodeHint) {}
+
+  mpeghuitranslator::SUiTranslatorPimpl state;
+  // Guards the last exception message only, the translator state is synchronized internally
+  std::mutex lock;
+  std::string lastException;
+  // Guards the scratch buffers, which are only used by one call at a time
+  std::mutex buffersLock;
+  SInstanceBuffers buffers;
+};
+
+static MpeghUiTranslatorInstance GLOBAL_INSTANCE{"eng"};
+
+/*!
+ * Provides the scratch buffers for a call of the public C interface: the buffers of the translator
+ * instance, or the buffers of the calling thread if another call currently uses them, so that
+ * concurrent calls on the same instance do not wait for each other.
+ */
+class CBuffersLease {
+ public:
+  explicit CBuffersLease(MpeghUiTranslatorInstance& instance)
+      : m_guard(instance.buffersLock, std::try_to_lock),
+        m_buffers(m_guard.owns_lock() ? instance.buffers : getThreadBuffers()) {}
+
+  SInstanceBuffers& get() { return m_buffers; }
+
+ private:
+  static SInstanceBuffers& getThreadBuffers() {
+    static thread_local SInstanceBuffers buffers;
+    return buffers;
+  }
+
+  std::unique_lock<std::mutex> m_guard;
+  SInstanceBuffers& m_buffers;
+};
+
+/*!
+ * Output stream buffer appending to a string, which in contrast to std::ostringstream keeps the
+ * capacity of the string when it is cleared.
+ */
+class CStringOutputBuffer : public std::streambuf {
+ public:
+  explicit CStringOutputBuffer(std::string& output) : m_output(output) {}
+
+ protected:
+  int_type overflow(int_type c) override {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      m_output.push_back(traits_type::to_char_type(c));
+    }
+    return traits_type::not_eof(c);
+  }
+
+  std::streamsize xsputn(const char* data, std::streamsize size) override {
+    m_output.append(data, static_cast<std::size_t>(size));
+    return size;
+  }
+
+ private:
+  std::string& m_output;
+};
+
+namespace mpeghuitranslator {
+
+////
+// Global-state public interface (simple.h)
+////
+
+Json::Value mpeghInteractivityToJson(const std::string& audioSceneXml) {
+  return translateAudioScene(GLOBAL_INSTANCE.state, audioSceneXml);
+}
+
+std::vector<std::string> mpeghInteractivityToXml(const Json::Value& sceneChangesJson) {
+  auto& state = GLOBAL_INSTANCE.state;
+  auto changes = parseSceneChanges(state, sceneChangesJson);
+  return translateToActionEventXml(state, changes);
+}
+
+}  // namespace mpeghuitranslator
+
+////
+// Public C interface (mpeghuitranslator_c.h)
+////
+
+static MpeghUiTranslatorStatusCode setLastError(MpeghUiTranslatorInstance& instance,
+                                                const std::exception& err) {
+  std::lock_guard<std::mutex> guard{instance.lock};
+  instance.lastException = err.what();
+  return MPEGHUITRANSLATOR_INTERNAL_ERROR;
+}
+
+/*!
+ * Reads and parses the given scene changes JSON text into the sceneChanges member of the given
+ * buffers, returns NULL if it is no valid JSON. The parsing is skipped if the text is the same as
+ * the one parsed last into the buffers.
+ */
+static const mpeghuitranslator::SAudioSceneChanges* parseSceneChanges(
+    MpeghUiTranslatorInstance& instance, SInstanceBuffers& buffers, const char* json,
+    size_t jsonSize) {
+  using namespace mpeghuitranslator;
+
+  instance.state.counters.addBytesIn(jsonSize);
+  const bool isValidated = instance.state.isSchemaValidationEnabled.load();
+  if (buffers.isSceneChangesValidated == isValidated &&
+      buffers.sceneChangesJson.compare(0, std::string::npos, json, jsonSize) == 0) {
+    return &buffers.sceneChanges;
+  }
+
+  CStageTimer timer{&instance.state.counters, STAGE_CHANGE_PARSE};
+  MPEGHUITRANSLATOR_PROBE1(parse_scene_changes_start, jsonSize);
+
+  // invalidated first, as the parsing below may fail after changing the parsed scene changes
+  buffers.sceneChangesJson.clear();
+  Json::Value value{};
+  if (!buffers.jsonReader->parse(json, json + jsonSize, &value, nullptr)) {
+    return nullptr;
+  }
+  buffers.sceneChanges = parseAudioSceneChanges(value, isValidated);
+  buffers.sceneChangesJson.assign(json, jsonSize);
+  buffers.isSceneChangesValidated = isValidated;
+  MPEGHUITRANSLATOR_PROBE3(parse_scene_changes_done, jsonSize, buffers.sceneChanges.uuid.c_str(),
+                           buffers.sceneChanges.presets.size());
+  return &buffers.sceneChanges;
+}
+
+/*!
+ * Copies the given ActionEvent XML strings into the given output string list.
+ *
+ * If the string list is not yet allocated (has a zero numStrings member), the list is allocated on
+ * the heap via malloc().
+ */
+static MpeghUiTranslatorStatusCode copyToStringList(const std::vector<std::string>& events,
+                                                   std::size_t numEvents,
+                                                   MpeghUiTranslatorStringList* outList) {
+  if (outList->numStrings > 0 && outList->numStrings < numEvents) {
+    outList->numStrings = numEvents;
+    return MPEGHUITRANSLATOR_INSUFFICIENT_SPACE;
+  } else if (outList->numStrings && !outList->strings) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  } else if (outList->numStrings == 0) {
+    outList->strings = reinterpret_cast<char**>(malloc(numEvents * sizeof(char*)));
+  }
+
+  outList->numStrings = numEvents;
+  for (std::size_t i = 0; i < numEvents; ++i) {
+    outList->strings[i] = reinterpret_cast<char*>(malloc((events[i].size() + 1) * sizeof(char)));
+    std::copy(events[i].begin(), events[i].end(), outList->strings[i]);
+    outList->strings[i][events[i].size()] = '\0';
+  }
+  return MPEGHUITRANSLATOR_OK;
+}
+
+/*!
+ * Writes the given JSON value into the JSON text buffer of the given buffers.
+ */
+static void writeJson(MpeghUiTranslatorInstance& instance, SInstanceBuffers& buffers,
+                      const Json::Value& value) {
+  buffers.json.clear();
+  buffers.jsonSnapshot.reset();
+
+  mpeghuitranslator::CStageTimer timer{&instance.state.counters,
+                                       mpeghuitranslator::STAGE_SERIALIZATION};
+  CStringOutputBuffer outputBuffer{buffers.json};
+  std::ostream output{&outputBuffer};
+  buffers.jsonWriter->write(value, &output);
+}
+
+/*!
+ * Copies the JSON text buffer of the given buffers into the given output buffer.
+ *
+ * If the output buffer is too small, MPEGHUITRANSLATOR_INSUFFICIENT_SPACE is returned and the
+ * required size is written to the outJsonBufferSize output parameter.
+ */
+static MpeghUiTranslatorStatusCode copyToJsonBuffer(MpeghUiTranslatorInstance& instance,
+                                                    const SInstanceBuffers& buffers,
+                                                    char* outJsonBuffer,
+                                                    size_t* outJsonBufferSize) {
+  const auto& json = buffers.json;
+  instance.state.counters.addBytesOut(json.size());
+
+  if (*outJsonBufferSize < json.size()) {
+    *outJsonBufferSize = json.size();
+    return MPEGHUITRANSLATOR_INSUFFICIENT_SPACE;
+  } else if (outJsonBuffer == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+
+  std::copy(json.begin(), json.end(), outJsonBuffer);
+  *outJsonBufferSize = json.size();
+  return MPEGHUITRANSLATOR_OK;
+}
+
+static MpeghUiTranslatorStatusCode translateToJson(MpeghUiTranslatorInstance& instance,
+                                                   const char* audioSceneXml,
+                                                   size_t audioSceneXmlSize, char* outJsonBuffer,
+                                                   size_t* outJsonBufferSize) try {
+  mpeghuitranslator::CAllocationScope allocationScope{};
+  if (audioSceneXml == nullptr || audioSceneXmlSize == 0 || outJsonBufferSize == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+
+  CBuffersLease lease{instance};
+  auto& buffers = lease.get();
+  auto snapshot = mpeghuitranslator::getLastAudioScene(instance.state);
+  // Parsing the same AudioScene XML again would only publish the current snapshot again
+  if (!snapshot || buffers.audioSceneSnapshot.lock() != snapshot ||
+      buffers.audioSceneXml.compare(0, std::string::npos, audioSceneXml, audioSceneXmlSize) != 0) {
+    buffers.audioSceneSnapshot.reset();
+    buffers.audioSceneXml.assign(audioSceneXml, audioSceneXmlSize);
+    snapshot = mpeghuitranslator::updateAudioScene(instance.state, buffers.audioSceneXml);
+    buffers.audioSceneSnapshot = snapshot;
+  } else {
+    instance.state.counters.addBytesIn(audioSceneXmlSize);
+  }
+  auto displayLanguage = mpeghuitranslator::getDisplayLanguage(instance.state);
+  // The JSON text only depends on the snapshot and the display language, e.g. a repeated query
+  // with a larger output buffer after MPEGHUITRANSLATOR_INSUFFICIENT_SPACE reuses it
+  if (buffers.jsonSnapshot.lock() != snapshot || buffers.jsonDisplayLanguage != displayLanguage) {
+    writeJson(instance, buffers,
+              mpeghuitranslator::composeAudioScene(instance.state, *snapshot, displayLanguage));
+    buffers.jsonSnapshot = snapshot;
+    buffers.jsonDisplayLanguage = displayLanguage;
+  }
+  return copyToJsonBuffer(instance, buffers, outJsonBuffer, outJsonBufferSize);
+
+} catch (const std::exception& err) {
+  return setLastError(instance, err);
+}
+
+static MpeghUiTranslatorStatusCode restoreSnapshot(MpeghUiTranslatorInstance& instance,
+                                                   const void* snapshot, size_t snapshotSize,
+                                                   char* outJsonBuffer,
+                                                   size_t* outJsonBufferSize) try {
+  mpeghuitranslator::CAllocationScope allocationScope{};
+  if (snapshot == nullptr || snapshotSize == 0 || outJsonBufferSize == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+
+  CBuffersLease lease{instance};
+  auto& buffers = lease.get();
+  writeJson(instance, buffers,
+            mpeghuitranslator::restoreAudioScene(instance.state, snapshot, snapshotSize));
+  return copyToJsonBuffer(instance, buffers, outJsonBuffer, outJsonBufferSize);
+
+} catch (const std::exception& err) {
+  return setLastError(instance, err);
+}
+
+static MpeghUiTranslatorStatusCode saveSnapshot(MpeghUiTranslatorInstance& instance,
+                                                uint8_t* outSnapshotBuffer,
+                                                size_t* outSnapshotBufferSize) try {
+  if (outSnapshotBufferSize == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+
+  std::vector<std::uint8_t> snapshot;
+  mpeghuitranslator::saveAudioScene(instance.state, snapshot);
+  if (*outSnapshotBufferSize < snapshot.size()) {
+    *outSnapshotBufferSize = snapshot.size();
+    return MPEGHUITRANSLATOR_INSUFFICIENT_SPACE;
+  } else if (outSnapshotBuffer == nullptr && !snapshot.empty()) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+
+  std::copy(snapshot.begin(), snapshot.end(), outSnapshotBuffer);
+  *outSnapshotBufferSize = snapshot.size();
+  return MPEGHUITRANSLATOR_OK;
+
+} catch (const std::exception& err) {
+  return setLastError(instance, err);
+}
+
+static MpeghUiTranslatorStatusCode translateToXml(
+    MpeghUiTranslatorInstance& instance, const char* sceneChangesJson, size_t sceneChangesJsonSize,
+    MpeghUiTranslatorStringList* outActionScenes) try {
+  using namespace mpeghuitranslator;
+  CAllocationScope allocationScope{};
+  if (sceneChangesJson == nullptr || sceneChangesJsonSize == 0 || outActionScenes == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+
+  CBuffersLease lease{instance};
+  auto& buffers = lease.get();
+  const auto* changes =
+      parseSceneChanges(instance, buffers, sceneChangesJson, sceneChangesJsonSize);
+  if (!changes) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+
+  auto status = MPEGHUITRANSLATOR_OK;
+  translateSceneChanges(instance.state, getLastAudioScene(instance.state), *changes,
+                        [&](const std::vector<SActionEvent>& events) {
+                          auto& eventStrings = buffers.actionEvents;
+                          composeActionEvents(instance.state, events, eventStrings);
+                          status = copyToStringList(eventStrings, events.size(), outActionScenes);
+                          return status == MPEGHUITRANSLATOR_OK;
+                        });
+  return status;
+
+} catch (const std::exception& err) {
+  return setLastError(instance, err);
+}
+
+/*!
+ * Copies the given string into the given fixed-size character array, including the terminating
+ * NUL character.
+ */
+template <std::size_t N>
+static void copyToCharArray(const std::string& value, char (&outArray)[N], const char* name) {
+  if (value.size() >= N) {
+    throw std::length_error{std::string{"ActionEvent "} + name + " is too long: " + value};
+  }
+  std::copy(value.begin(), value.end(), outArray);
+  outArray[value.size()] = '\0';
+}
 
-Json::Value CUiTranslator::mpeghInteractivityToJson(const std::string& audioSceneXml) {
-  if (!m_pimpl) {
-    m_pimpl.reset(new SUiTranslatorPimpl(""));
+static MpeghUiTranslatorActionEvent toPlainActionEvent(
+    const mpeghuitranslator::SActionEvent& event) {
+  MpeghUiTranslatorActionEvent out{};
+  out.actionType = event.actionType;
+  copyToCharArray(event.uuid, out.uuid, "uuid");
+  if (event.paramInt.isChanged) {
+    out.hasParamInt = 1;
+    out.paramInt = event.paramInt.newValue;
+  }
+  if (event.paramFloat.isChanged) {
+    out.hasParamFloat = 1;
+    out.paramFloat = static_cast<float>(event.paramFloat.newValue);
   }
+  if (event.selectedItemId.isChanged) {
+    out.hasParamFloat = 1;
+    out.paramFloat = static_cast<float>(event.selectedItemId.newValue);
+  }
+  if (event.paramBool.isChanged) {
+    out.hasParamBool = 1;
+    out.paramBool = event.paramBool.newValue ? 1 : 0;
+  }
+  if (event.paramText.isChanged) {
+    out.hasParamText = 1;
+    copyToCharArray(event.paramText.newValue, out.paramText, "paramText");
+  }
+  return out;
+}
 
-  SXmlString xml{audioSceneXml};
-  auto asi = parseAudioScene(xml.getRoot());
+/*!
+ * Copies the given ActionEvents into the given output ActionEvent list.
+ *
+ * If the list is not yet allocated (has a zero numEvents member), the list is allocated on the heap
+ * via malloc().
+ */
+static MpeghUiTranslatorStatusCode copyToActionEventList(
+    const std::vector<MpeghUiTranslatorActionEvent>& events,
+    MpeghUiTranslatorActionEventList* outList) {
+  if (outList->numEvents > 0 && outList->numEvents < events.size()) {
+    outList->numEvents = events.size();
+    return MPEGHUITRANSLATOR_INSUFFICIENT_SPACE;
+  } else if (outList->numEvents && !outList->events) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  } else if (outList->numEvents == 0) {
+    outList->events = reinterpret_cast<MpeghUiTranslatorActionEvent*>(
+        malloc(events.size() * sizeof(MpeghUiTranslatorActionEvent)));
+  }
 
-  std::lock_guard<std::mutex> guard{m_pimpl->lock};
-  m_pimpl->lastAudioScene.reset(new SAudioSceneConfig(std::move(asi)));
-  return composeAudioScene(*m_pimpl->lastAudioScene, m_pimpl->displayLanguageHint);
+  outList->numEvents = events.size();
+  std::copy(events.begin(), events.end(), outList->events);
+  return MPEGHUITRANSLATOR_OK;
 }
 
-std::vector<std::string> CUiTranslator::mpeghInteractivityToXml(
-    const Json::Value& sceneChangesJson) {
-  if (!m_pimpl) {
-    m_pimpl.reset(new SUiTranslatorPimpl(""));
+static MpeghUiTranslatorStatusCode translateToActionEvents(
+    MpeghUiTranslatorInstance& instance, const char* sceneChangesJson, size_t sceneChangesJsonSize,
+    MpeghUiTranslatorActionEventList* outActionEvents) try {
+  using namespace mpeghuitranslator;
+  CAllocationScope allocationScope{};
+  if (sceneChangesJson == nullptr || sceneChangesJsonSize == 0 || outActionEvents == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
   }
 
-  auto changes = parseAudioSceneChanges(sceneChangesJson);
+  CBuffersLease lease{instance};
+  const auto* changes =
+      parseSceneChanges(instance, lease.get(), sceneChangesJson, sceneChangesJsonSize);
+  if (!changes) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
 
-  std::lock_guard<std::mutex> guard{m_pimpl->lock};
-  auto result =
-      composeActionEvents(changes, m_pimpl->lastAudioScene.get(), &m_pimpl->displayLanguageHint);
+  auto status = MPEGHUITRANSLATOR_OK;
+  translateSceneChanges(instance.state, getLastAudioScene(instance.state), *changes,
+                        [&](const std::vector<SActionEvent>& events) {
+                          std::vector<MpeghUiTranslatorActionEvent> plainEvents;
+                          for (const auto& event : events) {
+                            plainEvents.push_back(toPlainActionEvent(event));
+                          }
+                          status = copyToActionEventList(plainEvents, outActionEvents);
+                          return status == MPEGHUITRANSLATOR_OK;
+                        });
+  return status;
 
-  if (changes.displayLanguage.isChanged) {
-    m_pimpl->displayLanguageHint = changes.displayLanguage.newValue;
+} catch (const std::exception& err) {
+  return setLastError(instance, err);
+}
+
+/*!
+ * Generates the ActionEvents for the changes filled in by the given function on top of the
+ * "last audio scene" state of the given translator instance.
+ */
+template <typename Func>
+static MpeghUiTranslatorStatusCode translateTypedChange(
+    MpeghUiTranslatorInstance& instance, Func&& fillChanges,
+    MpeghUiTranslatorStringList* outActionEvents) try {
+  using namespace mpeghuitranslator;
+  CAllocationScope allocationScope{};
+
+  if (outActionEvents == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+
+  auto snapshot = getLastAudioScene(instance.state);
+  SAudioSceneChanges changes{};
+  if (snapshot) {
+    changes.uuid = snapshot->config->uuid;
   }
+  fillChanges(changes);
+
+  CBuffersLease lease{instance};
+  auto status = MPEGHUITRANSLATOR_OK;
+  translateSceneChanges(instance.state, snapshot, changes,
+                        [&](const std::vector<SActionEvent>& events) {
+                          auto& eventStrings = lease.get().actionEvents;
+                          composeActionEvents(instance.state, events, eventStrings);
+                          status = copyToStringList(eventStrings, events.size(), outActionEvents);
+                          return status == MPEGHUITRANSLATOR_OK;
+                        });
+  return status;
+
+} catch (const std::exception& err) {
+  return setLastError(instance, err);
+}
+
+static mpeghuitranslator::SPresetChanges& addPresetChanges(
+    mpeghuitranslator::SAudioSceneChanges& changes, int presetId) {
+  changes.presets.emplace_back();
+  changes.presets.back().id = presetId;
+  return changes.presets.back();
+}
+
+static mpeghuitranslator::SAudioElementChanges& addElementChanges(
+    mpeghuitranslator::SAudioSceneChanges& changes, int presetId, int elementId) {
+  auto& presetChanges = addPresetChanges(changes, presetId);
+  presetChanges.audioElements.emplace_back();
+  presetChanges.audioElements.back().id = elementId;
+  return presetChanges.audioElements.back();
+}
+
+static mpeghuitranslator::SSwitchGroupChanges& addSwitchGroupChanges(
+    mpeghuitranslator::SAudioSceneChanges& changes, int presetId, int switchGroupId) {
+  auto& presetChanges = addPresetChanges(changes, presetId);
+  presetChanges.switchGroups.emplace_back();
+  presetChanges.switchGroups.back().id = switchGroupId;
+  return presetChanges.switchGroups.back();
+}
+
+static MpeghUiTranslatorStatusCode selectPreset(MpeghUiTranslatorInstance& instance,
+                                                int presetId,
+                                                MpeghUiTranslatorStringList* outActionEvents) {
+  return translateTypedChange(
+      instance,
+      [&](mpeghuitranslator::SAudioSceneChanges& changes) {
+        addPresetChanges(changes, presetId).isActive.set(true);
+      },
+      outActionEvents);
+}
+
+static MpeghUiTranslatorStatusCode setElementProminence(
+    MpeghUiTranslatorInstance& instance, int presetId, int elementId, float level,
+    MpeghUiTranslatorStringList* outActionEvents) {
+  return translateTypedChange(
+      instance,
+      [&](mpeghuitranslator::SAudioSceneChanges& changes) {
+        addElementChanges(changes, presetId, elementId).prominence.set(level);
+      },
+      outActionEvents);
+}
+
+static MpeghUiTranslatorStatusCode setElementMuting(MpeghUiTranslatorInstance& instance,
+                                                    int presetId, int elementId, int muted,
+                                                    MpeghUiTranslatorStringList* outActionEvents) {
+  return translateTypedChange(
+      instance,
+      [&](mpeghuitranslator::SAudioSceneChanges& changes) {
+        addElementChanges(changes, presetId, elementId).muting.set(muted != 0);
+      },
+      outActionEvents);
+}
+
+static MpeghUiTranslatorStatusCode setElementAzimuth(MpeghUiTranslatorInstance& instance,
+                                                     int presetId, int elementId, float offset,
+                                                     MpeghUiTranslatorStringList* outActionEvents) {
+  return translateTypedChange(
+      instance,
+      [&](mpeghuitranslator::SAudioSceneChanges& changes) {
+        addElementChanges(changes, presetId, elementId).azimuth.set(offset);
+      },
+      outActionEvents);
+}
+
+static MpeghUiTranslatorStatusCode setElementElevation(
+    MpeghUiTranslatorInstance& instance, int presetId, int elementId, float offset,
+    MpeghUiTranslatorStringList* outActionEvents) {
+  return translateTypedChange(
+      instance,
+      [&](mpeghuitranslator::SAudioSceneChanges& changes) {
+        addElementChanges(changes, presetId, elementId).elevation.set(offset);
+      },
+      outActionEvents);
+}
+
+static MpeghUiTranslatorStatusCode selectSwitchGroupItem(
+    MpeghUiTranslatorInstance& instance, int presetId, int switchGroupId, int itemId,
+    MpeghUiTranslatorStringList* outActionEvents) {
+  return translateTypedChange(
+      instance,
+      [&](mpeghuitranslator::SAudioSceneChanges& changes) {
+        addSwitchGroupChanges(changes, presetId, switchGroupId).activeObject.set(itemId);
+      },
+      outActionEvents);
+}
+
+static MpeghUiTranslatorStatusCode setSwitchGroupMuting(
+    MpeghUiTranslatorInstance& instance, int presetId, int switchGroupId, int muted,
+    MpeghUiTranslatorStringList* outActionEvents) {
+  return translateTypedChange(
+      instance,
+      [&](mpeghuitranslator::SAudioSceneChanges& changes) {
+        addSwitchGroupChanges(changes, presetId, switchGroupId).muting.set(muted != 0);
+      },
+      outActionEvents);
+}
+
+static MpeghUiTranslatorStageStatistics toPlainStageStatistics(
+    const mpeghuitranslator::SStageStatistics& stage) {
+  MpeghUiTranslatorStageStatistics result{};
+  result.numCalls = stage.numCalls;
+  result.totalNanoseconds = stage.totalNanoseconds;
+  result.maxNanoseconds = stage.maxNanoseconds;
   return result;
 }
 
-////
-// Global-state public interface (simple.h)
-////
+static MpeghUiTranslatorStatusCode getStatistics(MpeghUiTranslatorInstance& instance,
+                                                 MpeghUiTranslatorStatistics* outStatistics) {
+  if (outStatistics == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
 
-static std::mutex GLOBAL_LOCK{};
-static std::string GLOBAL_DISPLAY_LANGUAGE = "eng";
-static std::unique_ptr<SAudioSceneConfig> GLOBAL_CONFIG = nullptr;
-static std::string GLOBAL_LAST_EXCEPTION = "";
+  auto stats = instance.state.counters.load();
+  outStatistics->xmlParse = toPlainStageStatistics(stats.xmlParse);
+  outStatistics->modelBuild = toPlainStageStatistics(stats.modelBuild);
+  outStatistics->jsonCompose = toPlainStageStatistics(stats.jsonCompose);
+  outStatistics->serialization = toPlainStageStatistics(stats.serialization);
+  outStatistics->changeParse = toPlainStageStatistics(stats.changeParse);
+  outStatistics->actionEventCompose = toPlainStageStatistics(stats.actionEventCompose);
+  outStatistics->mutexWait = toPlainStageStatistics(stats.mutexWait);
+  outStatistics->bytesIn = stats.bytesIn;
+  outStatistics->bytesOut = stats.bytesOut;
+  outStatistics->numEvents = stats.numEvents;
+  return MPEGHUITRANSLATOR_OK;
+}
 
-Json::Value mpeghInteractivityToJson(const std::string& audioSceneXml) {
-  SXmlString xml{audioSceneXml};
-  auto asi = parseAudioScene(xml.getRoot());
+static MpeghUiTranslatorStatusCode getActivePreset(MpeghUiTranslatorInstance& instance,
+                                                   int* outPresetId) try {
+  if (outPresetId == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+
+  *outPresetId = mpeghuitranslator::queryActivePreset(getLastAudioScene(instance.state));
+  return MPEGHUITRANSLATOR_OK;
 
-  std::lock_guard<std::mutex> guard{GLOBAL_LOCK};
-  GLOBAL_CONFIG.reset(new SAudioSceneConfig(std::move(asi)));
-  return composeAudioScene(*GLOBAL_CONFIG, GLOBAL_DISPLAY_LANGUAGE);
+} catch (const std::exception& err) {
+  return setLastError(instance, err);
 }
 
-std::vector<std::string> mpeghInteractivityToXml(const Json::Value& sceneChangesJson) {
-  auto changes = parseAudioSceneChanges(sceneChangesJson);
+static MpeghUiTranslatorStatusCode getElementValues(MpeghUiTranslatorInstance& instance,
+                                                    int presetId, int elementId,
+                                                    int isSwitchGroup,
+                                                    MpeghUiTranslatorElementValues* outValues) try {
+  using namespace mpeghuitranslator;
 
-  std::lock_guard<std::mutex> guard{GLOBAL_LOCK};
-  auto result = composeActionEvents(changes, GLOBAL_CONFIG.get(), &GLOBAL_DISPLAY_LANGUAGE);
-  if (changes.displayLanguage.isChanged) {
-    GLOBAL_DISPLAY_LANGUAGE = changes.displayLanguage.newValue;
+  SElementValues values{};
+  if (outValues == nullptr ||
+      !queryElementValues(getLastAudioScene(instance.state),
+                          SElementRef{presetId, elementId, isSwitchGroup != 0}, values)) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
   }
 
-  return result;
+  outValues->isAvailable = values.isAvailable ? 1 : 0;
+  outValues->hasProminence = values.hasProminence ? 1 : 0;
+  outValues->prominence = values.prominence;
+  outValues->hasMuting = values.hasMuting ? 1 : 0;
+  outValues->isMuted = values.isMuted ? 1 : 0;
+  outValues->hasAzimuth = values.hasAzimuth ? 1 : 0;
+  outValues->azimuth = values.azimuth;
+  outValues->hasElevation = values.hasElevation ? 1 : 0;
+  outValues->elevation = values.elevation;
+  return MPEGHUITRANSLATOR_OK;
+
+} catch (const std::exception& err) {
+  return setLastError(instance, err);
 }
 
-}  // namespace mpeghuitranslator
+static MpeghUiTranslatorStatusCode getActiveSwitchGroupItem(MpeghUiTranslatorInstance& instance,
+                                                            int presetId, int switchGroupId,
+                                                            int* outItemId) try {
+  if (outItemId == nullptr ||
+      !mpeghuitranslator::queryActiveSwitchGroupItem(getLastAudioScene(instance.state), presetId,
+                                                     switchGroupId, *outItemId)) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+  return MPEGHUITRANSLATOR_OK;
+
+} catch (const std::exception& err) {
+  return setLastError(instance, err);
+}
+
+static MpeghUiTranslatorStatusCode getLabel(MpeghUiTranslatorInstance& instance,
+                                            mpeghuitranslator::EIndexedEntry entry, int presetId,
+                                            int id, const char* langCode, char* outLabelBuffer,
+                                            size_t* outLabelBufferSize) try {
+  mpeghuitranslator::SLangCode code{};
+  if (langCode == nullptr || outLabelBufferSize == nullptr ||
+      !mpeghuitranslator::toLangCode(langCode, code)) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+
+  // Keep the snapshot alive while copying the label
+  auto snapshot = getLastAudioScene(instance.state);
+  const auto* label = mpeghuitranslator::queryLabel(snapshot, entry, presetId, id, code);
+  if (label == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  } else if (*outLabelBufferSize < label->size()) {
+    *outLabelBufferSize = label->size();
+    return MPEGHUITRANSLATOR_INSUFFICIENT_SPACE;
+  } else if (outLabelBuffer == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+
+  std::copy(label->begin(), label->end(), outLabelBuffer);
+  *outLabelBufferSize = label->size();
+  return MPEGHUITRANSLATOR_OK;
+
+} catch (const std::exception& err) {
+  return setLastError(instance, err);
+}
+
+static MpeghUiTranslatorStatusCode getPresetLabel(MpeghUiTranslatorInstance& instance,
+                                                  int presetId, const char* langCode,
+                                                  char* outLabelBuffer,
+                                                  size_t* outLabelBufferSize) {
+  return getLabel(instance, mpeghuitranslator::EIndexedEntry::kPreset, -1, presetId, langCode,
+                  outLabelBuffer, outLabelBufferSize);
+}
+
+static MpeghUiTranslatorStatusCode getElementLabel(MpeghUiTranslatorInstance& instance,
+                                                   int presetId, int elementId, int isSwitchGroup,
+                                                   const char* langCode, char* outLabelBuffer,
+                                                   size_t* outLabelBufferSize) {
+  return getLabel(instance,
+                  isSwitchGroup ? mpeghuitranslator::EIndexedEntry::kSwitchGroup
+                                : mpeghuitranslator::EIndexedEntry::kAudioElement,
+                  presetId, elementId, langCode, outLabelBuffer, outLabelBufferSize);
+}
+
+static const char* getLastError(MpeghUiTranslatorInstance& instance,
+                                MpeghUiTranslatorStatusCode code) {
+  switch (code) {
+    case MPEGHUITRANSLATOR_INSUFFICIENT_SPACE:
+      return "Insufficient space in output parameter";
+    case MPEGHUITRANSLATOR_INVALID_ARGUMENT:
+      return "Invalid argument";
+    case MPEGHUITRANSLATOR_INTERNAL_ERROR: {
+      std::lock_guard<std::mutex> guard{instance.lock};
+      return instance.lastException.data();
+    }
+    case MPEGHUITRANSLATOR_OK:
+    default:
+      return nullptr;
+  }
+}
 
 ////
-// Public C interface (mpeghuitranslator_c.h)
+// Global-state public C interface
 ////
 
 MpeghUiTranslatorStatusCode mpeghUiTranslatorToJson(const char* audioSceneXml,
                                                     size_t audioSceneXmlSize, char* outJsonBuffer,
-                                                    size_t* outJsonBufferSize) try {
-  if (audioSceneXml == nullptr || audioSceneXmlSize == 0 || outJsonBufferSize == nullptr) {
+                                                    size_t* outJsonBufferSize) {
+  return translateToJson(GLOBAL_INSTANCE, audioSceneXml, audioSceneXmlSize, outJsonBuffer,
+                         outJsonBufferSize);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorToXml(const char* sceneChangesJson,
+                                                   size_t sceneChangesJsonSize,
+                                                   MpeghUiTranslatorStringList* outActionScenes) {
+  return translateToXml(GLOBAL_INSTANCE, sceneChangesJson, sceneChangesJsonSize, outActionScenes);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorToActionEvents(
+    const char* sceneChangesJson, size_t sceneChangesJsonSize,
+    MpeghUiTranslatorActionEventList* outActionEvents) {
+  return translateToActionEvents(GLOBAL_INSTANCE, sceneChangesJson, sceneChangesJsonSize,
+                                 outActionEvents);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSelectPreset(
+    int presetId, MpeghUiTranslatorStringList* outActionEvents) {
+  return selectPreset(GLOBAL_INSTANCE, presetId, outActionEvents);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSetElementProminence(
+    int presetId, int elementId, float level, MpeghUiTranslatorStringList* outActionEvents) {
+  return setElementProminence(GLOBAL_INSTANCE, presetId, elementId, level, outActionEvents);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSetElementMuting(
+    int presetId, int elementId, int muted, MpeghUiTranslatorStringList* outActionEvents) {
+  return setElementMuting(GLOBAL_INSTANCE, presetId, elementId, muted, outActionEvents);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSetElementAzimuth(
+    int presetId, int elementId, float offset, MpeghUiTranslatorStringList* outActionEvents) {
+  return setElementAzimuth(GLOBAL_INSTANCE, presetId, elementId, offset, outActionEvents);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSetElementElevation(
+    int presetId, int elementId, float offset, MpeghUiTranslatorStringList* outActionEvents) {
+  return setElementElevation(GLOBAL_INSTANCE, presetId, elementId, offset, outActionEvents);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSelectSwitchGroupItem(
+    int presetId, int switchGroupId, int itemId, MpeghUiTranslatorStringList* outActionEvents) {
+  return selectSwitchGroupItem(GLOBAL_INSTANCE, presetId, switchGroupId, itemId, outActionEvents);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSetSwitchGroupMuting(
+    int presetId, int switchGroupId, int muted, MpeghUiTranslatorStringList* outActionEvents) {
+  return setSwitchGroupMuting(GLOBAL_INSTANCE, presetId, switchGroupId, muted, outActionEvents);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetStatistics(
+    MpeghUiTranslatorStatistics* outStatistics) {
+  return getStatistics(GLOBAL_INSTANCE, outStatistics);
+}
+
+void mpeghUiTranslatorSetSchemaValidation(int enabled) {
+  GLOBAL_INSTANCE.state.isSchemaValidationEnabled = enabled != 0;
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetLastCallAllocations(
+    MpeghUiTranslatorAllocationReport* outReport) {
+  if (outReport == nullptr) {
     return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
   }
 
-  Json::StreamWriterBuilder builder{};
-  auto json = Json::writeString(builder, mpeghuitranslator::mpeghInteractivityToJson(std::string(
-                                             audioSceneXml, audioSceneXml + audioSceneXmlSize)));
+  auto report = mpeghuitranslator::getLastCallAllocations();
+  outReport->isEnabled = report.isEnabled ? 1 : 0;
+  outReport->numAllocations = report.numAllocations;
+  outReport->numBytes = report.numBytes;
+  outReport->numXmlAllocations = report.numXmlAllocations;
+  outReport->numXmlBytes = report.numXmlBytes;
+  return MPEGHUITRANSLATOR_OK;
+}
 
-  if (*outJsonBufferSize < json.size()) {
-    *outJsonBufferSize = json.size();
-    return MPEGHUITRANSLATOR_INSUFFICIENT_SPACE;
-  } else if (outJsonBuffer == nullptr) {
+MpeghUiTranslatorStatusCode mpeghUiTranslatorSaveSnapshot(uint8_t* outSnapshotBuffer,
+                                                         size_t* outSnapshotBufferSize) {
+  return saveSnapshot(GLOBAL_INSTANCE, outSnapshotBuffer, outSnapshotBufferSize);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorRestoreSnapshot(const void* snapshot,
+                                                            size_t snapshotSize,
+                                                            char* outJsonBuffer,
+                                                            size_t* outJsonBufferSize) {
+  return restoreSnapshot(GLOBAL_INSTANCE, snapshot, snapshotSize, outJsonBuffer,
+                         outJsonBufferSize);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetActivePreset(int* outPresetId) {
+  return getActivePreset(GLOBAL_INSTANCE, outPresetId);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetElementValues(
+    int presetId, int elementId, int isSwitchGroup, MpeghUiTranslatorElementValues* outValues) {
+  return getElementValues(GLOBAL_INSTANCE, presetId, elementId, isSwitchGroup, outValues);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetActiveSwitchGroupItem(int presetId,
+                                                                      int switchGroupId,
+                                                                      int* outItemId) {
+  return getActiveSwitchGroupItem(GLOBAL_INSTANCE, presetId, switchGroupId, outItemId);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetPresetLabel(int presetId, const char* langCode,
+                                                            char* outLabelBuffer,
+                                                            size_t* outLabelBufferSize) {
+  return getPresetLabel(GLOBAL_INSTANCE, presetId, langCode, outLabelBuffer, outLabelBufferSize);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorGetElementLabel(int presetId, int elementId,
+                                                             int isSwitchGroup,
+                                                             const char* langCode,
+                                                             char* outLabelBuffer,
+                                                             size_t* outLabelBufferSize) {
+  return getElementLabel(GLOBAL_INSTANCE, presetId, elementId, isSwitchGroup, langCode,
+                         outLabelBuffer, outLabelBufferSize);
+}
+
+const char* mpeghUiTranslatorLastError(MpeghUiTranslatorStatusCode code) {
+  return getLastError(GLOBAL_INSTANCE, code);
+}
+
+////
+// Handle-based public C interface
+////
+
+MpeghUiTranslatorHandle mpeghUiTranslatorCreate(const char* initialDisplayLanguageCodeHint) try {
+  return new MpeghUiTranslatorInstance(
+      initialDisplayLanguageCodeHint ? initialDisplayLanguageCodeHint : "");
+} catch (const std::exception&) {
+  return nullptr;
+}
+
+void mpeghUiTranslatorDestroy(MpeghUiTranslatorHandle handle) { delete handle; }
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleToJson(MpeghUiTranslatorHandle handle,
+                                                          const char* audioSceneXml,
+                                                          size_t audioSceneXmlSize,
+                                                          char* outJsonBuffer,
+                                                          size_t* outJsonBufferSize) {
+  if (handle == nullptr) {
     return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
   }
+  return translateToJson(*handle, audioSceneXml, audioSceneXmlSize, outJsonBuffer,
+                         outJsonBufferSize);
+}
 
-  std::copy(json.begin(), json.end(), outJsonBuffer);
-  *outJsonBufferSize = json.size();
-  return MPEGHUITRANSLATOR_OK;
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleToXml(
+    MpeghUiTranslatorHandle handle, const char* sceneChangesJson, size_t sceneChangesJsonSize,
+    MpeghUiTranslatorStringList* outActionScenes) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+  return translateToXml(*handle, sceneChangesJson, sceneChangesJsonSize, outActionScenes);
+}
 
-} catch (const std::exception& err) {
-  std::lock_guard<std::mutex> guard{mpeghuitranslator::GLOBAL_LOCK};
-  mpeghuitranslator::GLOBAL_LAST_EXCEPTION = err.what();
-  return MPEGHUITRANSLATOR_INTERNAL_ERROR;
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleToActionEvents(
+    MpeghUiTranslatorHandle handle, const char* sceneChangesJson, size_t sceneChangesJsonSize,
+    MpeghUiTranslatorActionEventList* outActionEvents) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+  return translateToActionEvents(*handle, sceneChangesJson, sceneChangesJsonSize,
+                                 outActionEvents);
 }
 
-MpeghUiTranslatorStatusCode mpeghUiTranslatorToXml(
-    const char* sceneChangesJson, size_t sceneChangesJsonSize,
-    MpeghUiTranslatorStringList* outActionScenes) try {
-  if (sceneChangesJson == nullptr || sceneChangesJsonSize == 0 || outActionScenes == nullptr) {
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSelectPreset(
+    MpeghUiTranslatorHandle handle, int presetId, MpeghUiTranslatorStringList* outActionEvents) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+  return selectPreset(*handle, presetId, outActionEvents);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSetElementProminence(
+    MpeghUiTranslatorHandle handle, int presetId, int elementId, float level,
+    MpeghUiTranslatorStringList* outActionEvents) {
+  if (handle == nullptr) {
     return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
   }
+  return setElementProminence(*handle, presetId, elementId, level, outActionEvents);
+}
 
-  std::unique_ptr<Json::CharReader> jsonReader{Json::CharReaderBuilder{}.newCharReader()};
-  Json::Value json{};
-  if (!jsonReader->parse(sceneChangesJson, sceneChangesJson + sceneChangesJsonSize, &json,
-                         nullptr)) {
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSetElementMuting(
+    MpeghUiTranslatorHandle handle, int presetId, int elementId, int muted,
+    MpeghUiTranslatorStringList* outActionEvents) {
+  if (handle == nullptr) {
     return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
   }
+  return setElementMuting(*handle, presetId, elementId, muted, outActionEvents);
+}
 
-  std::string oldDisplayLanguage;
-  {
-    std::lock_guard<std::mutex> guard{mpeghuitranslator::GLOBAL_LOCK};
-    oldDisplayLanguage = mpeghuitranslator::GLOBAL_DISPLAY_LANGUAGE;
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSetElementAzimuth(
+    MpeghUiTranslatorHandle handle, int presetId, int elementId, float offset,
+    MpeghUiTranslatorStringList* outActionEvents) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
   }
+  return setElementAzimuth(*handle, presetId, elementId, offset, outActionEvents);
+}
 
-  auto events = mpeghuitranslator::mpeghInteractivityToXml(json);
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSetElementElevation(
+    MpeghUiTranslatorHandle handle, int presetId, int elementId, float offset,
+    MpeghUiTranslatorStringList* outActionEvents) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+  return setElementElevation(*handle, presetId, elementId, offset, outActionEvents);
+}
 
-  if (outActionScenes->numStrings > 0 && outActionScenes->numStrings < events.size()) {
-    std::lock_guard<std::mutex> guard{mpeghuitranslator::GLOBAL_LOCK};
-    mpeghuitranslator::GLOBAL_DISPLAY_LANGUAGE = oldDisplayLanguage;
-    outActionScenes->numStrings = events.size();
-    return MPEGHUITRANSLATOR_INSUFFICIENT_SPACE;
-  } else if (outActionScenes->numStrings && !outActionScenes->strings) {
-    std::lock_guard<std::mutex> guard{mpeghuitranslator::GLOBAL_LOCK};
-    mpeghuitranslator::GLOBAL_DISPLAY_LANGUAGE = oldDisplayLanguage;
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSelectSwitchGroupItem(
+    MpeghUiTranslatorHandle handle, int presetId, int switchGroupId, int itemId,
+    MpeghUiTranslatorStringList* outActionEvents) {
+  if (handle == nullptr) {
     return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
-  } else if (outActionScenes->numStrings == 0) {
-    outActionScenes->strings = reinterpret_cast<char**>(malloc(events.size() * sizeof(char*)));
-    outActionScenes->numStrings = events.size();
   }
+  return selectSwitchGroupItem(*handle, presetId, switchGroupId, itemId, outActionEvents);
+}
 
-  outActionScenes->numStrings = events.size();
-  for (std::size_t i = 0; i < events.size(); ++i) {
-    outActionScenes->strings[i] = reinterpret_cast<char*>(malloc(events[i].size() * sizeof(char)));
-    std::copy(events[i].begin(), events[i].end(), outActionScenes->strings[i]);
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSetSwitchGroupMuting(
+    MpeghUiTranslatorHandle handle, int presetId, int switchGroupId, int muted,
+    MpeghUiTranslatorStringList* outActionEvents) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
   }
-  return MPEGHUITRANSLATOR_OK;
+  return setSwitchGroupMuting(*handle, presetId, switchGroupId, muted, outActionEvents);
+}
 
-} catch (const std::exception& err) {
-  std::lock_guard<std::mutex> guard{mpeghuitranslator::GLOBAL_LOCK};
-  mpeghuitranslator::GLOBAL_LAST_EXCEPTION = err.what();
-  return MPEGHUITRANSLATOR_INTERNAL_ERROR;
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleGetStatistics(
+    MpeghUiTranslatorHandle handle, MpeghUiTranslatorStatistics* outStatistics) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+  return getStatistics(*handle, outStatistics);
+}
+
+void mpeghUiTranslatorHandleSetSchemaValidation(MpeghUiTranslatorHandle handle, int enabled) {
+  if (handle) {
+    handle->state.isSchemaValidationEnabled = enabled != 0;
+  }
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleSaveSnapshot(MpeghUiTranslatorHandle handle,
+                                                               uint8_t* outSnapshotBuffer,
+                                                               size_t* outSnapshotBufferSize) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+  return saveSnapshot(*handle, outSnapshotBuffer, outSnapshotBufferSize);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleRestoreSnapshot(MpeghUiTranslatorHandle handle,
+                                                                  const void* snapshot,
+                                                                  size_t snapshotSize,
+                                                                  char* outJsonBuffer,
+                                                                  size_t* outJsonBufferSize) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+  return restoreSnapshot(*handle, snapshot, snapshotSize, outJsonBuffer, outJsonBufferSize);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleGetActivePreset(MpeghUiTranslatorHandle handle,
+                                                                   int* outPresetId) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+  return getActivePreset(*handle, outPresetId);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleGetElementValues(
+    MpeghUiTranslatorHandle handle, int presetId, int elementId, int isSwitchGroup,
+    MpeghUiTranslatorElementValues* outValues) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+  return getElementValues(*handle, presetId, elementId, isSwitchGroup, outValues);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleGetActiveSwitchGroupItem(
+    MpeghUiTranslatorHandle handle, int presetId, int switchGroupId, int* outItemId) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+  return getActiveSwitchGroupItem(*handle, presetId, switchGroupId, outItemId);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleGetPresetLabel(MpeghUiTranslatorHandle handle,
+                                                                  int presetId,
+                                                                  const char* langCode,
+                                                                  char* outLabelBuffer,
+                                                                  size_t* outLabelBufferSize) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+  return getPresetLabel(*handle, presetId, langCode, outLabelBuffer, outLabelBufferSize);
+}
+
+MpeghUiTranslatorStatusCode mpeghUiTranslatorHandleGetElementLabel(
+    MpeghUiTranslatorHandle handle, int presetId, int elementId, int isSwitchGroup,
+    const char* langCode, char* outLabelBuffer, size_t* outLabelBufferSize) {
+  if (handle == nullptr) {
+    return MPEGHUITRANSLATOR_INVALID_ARGUMENT;
+  }
+  return getElementLabel(*handle, presetId, elementId, isSwitchGroup, langCode, outLabelBuffer,
+                         outLabelBufferSize);
+}
+
+const char* mpeghUiTranslatorHandleLastError(MpeghUiTranslatorHandle handle,
+                                             MpeghUiTranslatorStatusCode code) {
+  if (handle == nullptr) {
+    return nullptr;
+  }
+  return getLastError(*handle, code);
 }
 
+////
+// Memory management helpers
+////
+
 void mpeghUiTranslatorFreeStrings(MpeghUiTranslatorStringList* list) {
   if (!list || !list->strings) {
     return;
@@ -278,18 +1731,12 @@ void mpeghUiTranslatorFreeStrings(MpeghUiTranslatorStringList* list) {
   list->numStrings = 0;
 }
 
-const char* mpeghUiTranslatorLastError(MpeghUiTranslatorStatusCode code) {
-  switch (code) {
-    case MPEGHUITRANSLATOR_INSUFFICIENT_SPACE:
-      return "Insufficient space in output parameter";
-    case MPEGHUITRANSLATOR_INVALID_ARGUMENT:
-      return "Invalid argument";
-    case MPEGHUITRANSLATOR_INTERNAL_ERROR: {
-      std::lock_guard<std::mutex> guard{mpeghuitranslator::GLOBAL_LOCK};
-      return mpeghuitranslator::GLOBAL_LAST_EXCEPTION.data();
-    }
-    case MPEGHUITRANSLATOR_OK:
-    default:
-      return nullptr;
+void mpeghUiTranslatorFreeActionEvents(MpeghUiTranslatorActionEventList* list) {
+  if (!list || !list->events) {
+    return;
   }
+
+  free(list->events);
+  list->events = nullptr;
+  list->numEvents = 0;
 }
@@ -0,0 +1,402 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// Internal headers
+#include "mpeghuitranslator/registry.h"
+
+// External headers
+#include "json/value.h"
+
+// System headers
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace mpeghuitranslator {
+
+using SClock = std::chrono::steady_clock;
+
+struct SSession {
+  std::string id;
+  std::shared_ptr<CUiTranslator> translator;
+  SClock::time_point lastUsed;
+  // Estimated private memory of this session as accounted in the registry
+  std::size_t memoryBytes;
+  // Shared AudioScene structure referenced by this session as accounted in the registry
+  std::shared_ptr<const void> structure;
+};
+
+/*!
+ * Shared AudioScene structure referenced by at least one session of a registry.
+ */
+struct SStructureUsage {
+  std::size_t numSessions;
+  std::size_t memoryBytes;
+};
+
+struct SSessionShard {
+  std::mutex lock;
+  // Ordered by last usage, the most recently used session first
+  std::list<SSession> sessions;
+  std::unordered_map<std::string, std::list<SSession>::iterator> index;
+};
+
+struct SSessionRegistryPimpl {
+  explicit SSessionRegistryPimpl(const SSessionRegistryConfig& registryConfig)
+      : config(registryConfig), shards(std::max<std::size_t>(registryConfig.numShards, 1)) {}
+
+  const SSessionRegistryConfig config;
+  std::vector<SSessionShard> shards;
+
+  std::atomic<std::size_t> numSessions{0};
+  // Sum of the private memory of all sessions and of the shared AudioScene structures referenced
+  // by them, each structure counted once
+  std::atomic<std::size_t> memoryBytes{0};
+  // Shared AudioScene structures referenced by the sessions, locked after a shard lock if both are
+  // held
+  std::mutex structuresLock;
+  std::unordered_map<const void*, SStructureUsage> structures;
+  // Shard to evict the next session from when the registry limits are exceeded
+  std::atomic<std::size_t> evictionCursor{0};
+  // Shard to check for idle sessions next, in addition to the shard of the accessed session
+  std::atomic<std::size_t> idleEvictionCursor{0};
+
+  std::atomic<std::uint64_t> numSessionsCreated{0};
+  std::atomic<std::uint64_t> numSessionsRemoved{0};
+  std::atomic<std::uint64_t> numSessionsEvicted{0};
+  std::atomic<std::uint64_t> numIdleSessionsEvicted{0};
+  std::atomic<std::uint64_t> numToJsonCalls{0};
+  std::atomic<std::uint64_t> numToXmlCalls{0};
+};
+
+static std::size_t estimateSessionMemory(const std::string& sessionId,
+                                         const CUiTranslator& translator) {
+  // The shared AudioScene structures are accounted once per registry, see setSessionStructure()
+  return sizeof(SSession) + sessionId.capacity() +
+         translator.getMemoryUsage(false /* includeSharedStructure */);
+}
+
+/*!
+ * Replaces the shared AudioScene structure accounted for the given session. A structure is charged
+ * to the registry when the first of its sessions references it and released when the last one
+ * stops referencing it, independent of other registries or translators sharing it.
+ */
+static void setSessionStructure(SSessionRegistryPimpl& registry, SSession& session,
+                                std::shared_ptr<const void> structure, std::size_t memoryBytes) {
+  if (structure == session.structure) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard{registry.structuresLock};
+  if (structure) {
+    auto& usage = registry.structures[structure.get()];
+    if (usage.numSessions++ == 0) {
+      usage.memoryBytes = memoryBytes;
+      registry.memoryBytes.fetch_add(memoryBytes);
+    }
+  }
+  if (session.structure) {
+    auto it = registry.structures.find(session.structure.get());
+    if (--it->second.numSessions == 0) {
+      registry.memoryBytes.fetch_sub(it->second.memoryBytes);
+      registry.structures.erase(it);
+    }
+  }
+  session.structure = std::move(structure);
+}
+
+static SSessionShard& selectShard(SSessionRegistryPimpl& registry, const std::string& sessionId) {
+  return registry.shards[std::hash<std::string>{}(sessionId) % registry.shards.size()];
+}
+
+/*!
+ * Removes the given session from the given shard, the shard lock needs to be held by the caller.
+ */
+static void eraseSession(SSessionRegistryPimpl& registry, SSessionShard& shard,
+                         std::list<SSession>::iterator session) {
+  registry.numSessions.fetch_sub(1);
+  registry.memoryBytes.fetch_sub(session->memoryBytes);
+  setSessionStructure(registry, *session, nullptr, 0);
+  shard.index.erase(session->id);
+  shard.sessions.erase(session);
+}
+
+/*!
+ * Evicts the sessions of the given shard which exceed the configured idle time, the shard lock
+ * needs to be held by the caller.
+ */
+static std::size_t evictIdleSessions(SSessionRegistryPimpl& registry, SSessionShard& shard,
+                                     SClock::time_point now) {
+  if (registry.config.maxIdleTime.count() == 0) {
+    return 0;
+  }
+
+  std::size_t numEvicted = 0;
+  while (!shard.sessions.empty() &&
+         now - shard.sessions.back().lastUsed > registry.config.maxIdleTime) {
+    eraseSession(registry, shard, std::prev(shard.sessions.end()));
+    ++numEvicted;
+  }
+  registry.numIdleSessionsEvicted.fetch_add(numEvicted);
+  return numEvicted;
+}
+
+/*!
+ * Evicts the idle sessions of the next shard in round-robin order, so that idle sessions are also
+ * evicted from shards which are not accessed anymore. The shard is skipped if it is currently
+ * locked, it will be visited again in the next round.
+ */
+static void evictIdleSessionsRoundRobin(SSessionRegistryPimpl& registry, SClock::time_point now) {
+  if (registry.config.maxIdleTime.count() == 0) {
+    return;
+  }
+
+  auto& shard = registry.shards[registry.idleEvictionCursor.fetch_add(1) % registry.shards.size()];
+  std::unique_lock<std::mutex> guard{shard.lock, std::try_to_lock};
+  if (guard.owns_lock()) {
+    evictIdleSessions(registry, shard, now);
+  }
+}
+
+/*!
+ * Evicts least recently used sessions until the configured session and memory limits are satisfied.
+ *
+ * The session with the given translator is never evicted, since it is currently in use by the
+ * caller.
+ */
+static void enforceLimits(SSessionRegistryPimpl& registry, const CUiTranslator* keep) {
+  const auto& config = registry.config;
+  auto isExceeded = [&]() {
+    return (config.maxSessions && registry.numSessions.load() > config.maxSessions) ||
+           (config.maxMemoryBytes && registry.memoryBytes.load() > config.maxMemoryBytes);
+  };
+
+  // Stop after one full round over all shards without any evictable session
+  std::size_t numUnsuccessful = 0;
+  while (isExceeded() && numUnsuccessful < registry.shards.size()) {
+    auto& shard = registry.shards[registry.evictionCursor.fetch_add(1) % registry.shards.size()];
+
+    std::lock_guard<std::mutex> guard{shard.lock};
+    if (shard.sessions.empty() || shard.sessions.back().translator.get() == keep) {
+      ++numUnsuccessful;
+      continue;
+    }
+    eraseSession(registry, shard, std::prev(shard.sessions.end()));
+    registry.numSessionsEvicted.fetch_add(1);
+    numUnsuccessful = 0;
+  }
+}
+
+/*!
+ * Returns the translator of the session with the given ID, creating the session if required, and
+ * marks it as most recently used.
+ */
+static std::shared_ptr<CUiTranslator> acquireSession(SSessionRegistryPimpl& registry,
+                                                     const std::string& sessionId) {
+  auto& shard = selectShard(registry, sessionId);
+  auto now = SClock::now();
+  evictIdleSessionsRoundRobin(registry, now);
+
+  std::shared_ptr<CUiTranslator> translator;
+  {
+    std::lock_guard<std::mutex> guard{shard.lock};
+    evictIdleSessions(registry, shard, now);
+
+    auto it = shard.index.find(sessionId);
+    if (it != shard.index.end()) {
+      shard.sessions.splice(shard.sessions.begin(), shard.sessions, it->second);
+      it->second->lastUsed = now;
+      return it->second->translator;
+    }
+
+    translator = std::make_shared<CUiTranslator>(registry.config.initialDisplayLanguageCodeHint);
+    auto memoryBytes = estimateSessionMemory(sessionId, *translator);
+    shard.sessions.push_front(SSession{sessionId, translator, now, memoryBytes, nullptr});
+    shard.index.emplace(sessionId, shard.sessions.begin());
+
+    registry.numSessions.fetch_add(1);
+    registry.memoryBytes.fetch_add(memoryBytes);
+    registry.numSessionsCreated.fetch_add(1);
+  }
+
+  enforceLimits(registry, translator.get());
+  return translator;
+}
+
+/*!
+ * Updates the accounted memory of the session with the given ID after its translator state changed.
+ */
+static void updateSessionMemory(SSessionRegistryPimpl& registry, const std::string& sessionId,
+                                const std::shared_ptr<CUiTranslator>& translator) {
+  auto memoryBytes = estimateSessionMemory(sessionId, *translator);
+  std::size_t structureMemoryBytes = 0;
+  auto structure = translator->getSharedStructure(structureMemoryBytes);
+  {
+    auto& shard = selectShard(registry, sessionId);
+    std::lock_guard<std::mutex> guard{shard.lock};
+    auto it = shard.index.find(sessionId);
+    if (it == shard.index.end() || it->second->translator != translator) {
+      // session was evicted in the meantime
+      return;
+    }
+    registry.memoryBytes.fetch_add(memoryBytes);
+    registry.memoryBytes.fetch_sub(it->second->memoryBytes);
+    it->second->memoryBytes = memoryBytes;
+    setSessionStructure(registry, *it->second, std::move(structure), structureMemoryBytes);
+  }
+
+  enforceLimits(registry, translator.get());
+}
+
+CSessionRegistry::CSessionRegistry(const SSessionRegistryConfig& config)
+    : m_pimpl(new SSessionRegistryPimpl(config)) {}
+
+CSessionRegistry::~CSessionRegistry() noexcept = default;
+
+Json::Value CSessionRegistry::mpeghInteractivityToJson(const std::string& sessionId,
+                                                       const std::string& audioSceneXml) {
+  m_pimpl->numToJsonCalls.fetch_add(1);
+  auto translator = acquireSession(*m_pimpl, sessionId);
+  auto result = translator->mpeghInteractivityToJson(audioSceneXml);
+  updateSessionMemory(*m_pimpl, sessionId, translator);
+  return result;
+}
+
+std::vector<std::string> CSessionRegistry::mpeghInteractivityToXml(
+    const std::string& sessionId, const Json::Value& sceneChangesJson) {
+  m_pimpl->numToXmlCalls.fetch_add(1);
+  auto translator = acquireSession(*m_pimpl, sessionId);
+  auto result = translator->mpeghInteractivityToXml(sceneChangesJson);
+  updateSessionMemory(*m_pimpl, sessionId, translator);
+  return result;
+}
+
+std::shared_ptr<CUiTranslator> CSessionRegistry::getSession(const std::string& sessionId) {
+  return acquireSession(*m_pimpl, sessionId);
+}
+
+bool CSessionRegistry::removeSession(const std::string& sessionId) {
+  auto& shard = selectShard(*m_pimpl, sessionId);
+  std::lock_guard<std::mutex> guard{shard.lock};
+  auto it = shard.index.find(sessionId);
+  if (it == shard.index.end()) {
+    return false;
+  }
+  eraseSession(*m_pimpl, shard, it->second);
+  m_pimpl->numSessionsRemoved.fetch_add(1);
+  return true;
+}
+
+std::size_t CSessionRegistry::evictIdleSessions() {
+  auto now = SClock::now();
+  std::size_t numEvicted = 0;
+  for (auto& shard : m_pimpl->shards) {
+    std::lock_guard<std::mutex> guard{shard.lock};
+    numEvicted += mpeghuitranslator::evictIdleSessions(*m_pimpl, shard, now);
+  }
+  return numEvicted;
+}
+
+SSessionRegistryStatistics CSessionRegistry::getStatistics() const {
+  SSessionRegistryStatistics stats{};
+  stats.numSessions = m_pimpl->numSessions.load();
+  stats.sharedMemoryBytes = CUiTranslator::getSharedMemoryUsage();
+  stats.memoryBytes = m_pimpl->memoryBytes.load();
+  stats.numSessionsCreated = m_pimpl->numSessionsCreated.load();
+  stats.numSessionsRemoved = m_pimpl->numSessionsRemoved.load();
+  stats.numSessionsEvicted = m_pimpl->numSessionsEvicted.load();
+  stats.numIdleSessionsEvicted = m_pimpl->numIdleSessionsEvicted.load();
+  stats.numToJsonCalls = m_pimpl->numToJsonCalls.load();
+  stats.numToXmlCalls = m_pimpl->numToXmlCalls.load();
+
+  for (auto& shard : m_pimpl->shards) {
+    std::lock_guard<std::mutex> guard{shard.lock};
+    stats.maxSessionsPerShard = std::max(stats.maxSessionsPerShard, shard.sessions.size());
+  }
+  return stats;
+}
+
+}  // namespace mpeghuitranslator
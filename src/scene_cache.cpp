@@ -0,0 +1,386 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// Internal headers
+#include "scene_cache.h"
+#include "scene_index.h"
+#include "xml_helper.h"
+
+// System headers
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace mpeghuitranslator {
+
+////
+// Structural hash and comparison, both ignoring the current values
+////
+
+template <typename T>
+static void combineHash(std::size_t& seed, const T& value) {
+  seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+template <typename T>
+static void hashLabels(std::size_t& seed, const std::unique_ptr<T>& customKind) {
+  combineHash(seed, customKind != nullptr);
+  if (customKind) {
+    for (const auto& label : customKind->description) {
+      combineHash(seed, label.langCode);
+      combineHash(seed, label.value);
+    }
+  }
+}
+
+template <typename T>
+static void hashElement(std::size_t& seed, const T& element) {
+  combineHash(seed, element.id);
+  combineHash(seed, element.isAvailable);
+  combineHash(seed, element.prominence != nullptr);
+  combineHash(seed, element.muting != nullptr);
+  combineHash(seed, element.azimuth != nullptr);
+  combineHash(seed, element.elevation != nullptr);
+  hashLabels(seed, element.customKind);
+}
+
+static void hashElements(std::size_t& seed, const std::vector<SAudioElement>& elements) {
+  combineHash(seed, elements.size());
+  for (const auto& element : elements) {
+    hashElement(seed, element);
+  }
+}
+
+static void hashSwitchGroups(std::size_t& seed, const std::vector<SAudioElementSwitch>& groups) {
+  combineHash(seed, groups.size());
+  for (const auto& group : groups) {
+    hashElement(seed, group);
+    combineHash(seed, group.audioElements.size());
+    for (const auto& item : group.audioElements) {
+      combineHash(seed, item.id);
+      hashLabels(seed, item.customKind);
+    }
+  }
+}
+
+/*!
+ * Returns a hash of the structure of the given AudioScene config. Not all parts of the structure
+ * are hashed, equal hashes are verified with #isSameStructure().
+ */
+static std::size_t hashStructure(const SAudioSceneConfig& asi) {
+  std::size_t seed = std::hash<std::string>{}(asi.uuid);
+  combineHash(seed, asi.version);
+  combineHash(seed, asi.presets.size());
+  for (const auto& preset : asi.presets) {
+    combineHash(seed, preset.id);
+    hashLabels(seed, preset.customKind);
+    hashElements(seed, preset.audioElements);
+    hashSwitchGroups(seed, preset.switchGroups);
+  }
+  hashElements(seed, asi.audioElements);
+  hashSwitchGroups(seed, asi.switchGroups);
+  return seed;
+}
+
+static bool isSameStructure(const SLocalizedString& a, const SLocalizedString& b) {
+  return a.langCode == b.langCode && a.value == b.value;
+}
+
+static bool isSameStructure(const SCustomDescriptor& a, const SCustomDescriptor& b);
+
+template <typename T>
+static bool isSameStructure(const std::vector<T>& a, const std::vector<T>& b) {
+  return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+                                            [](const T& entryA, const T& entryB) {
+                                              return isSameStructure(entryA, entryB);
+                                            });
+}
+
+template <typename T>
+static bool isSameStructure(const std::unique_ptr<T>& a, const std::unique_ptr<T>& b) {
+  if (!a || !b) {
+    return !a && !b;
+  }
+  return isSameStructure(*a, *b);
+}
+
+static bool isSameStructure(const SCustomDescriptor& a, const SCustomDescriptor& b) {
+  return isSameStructure(a.description, b.description);
+}
+
+static bool isSameStructure(const SCustomAudioElementKind& a, const SCustomAudioElementKind& b) {
+  return a.langCode == b.langCode && isSameStructure(a.description, b.description);
+}
+
+static bool isSameTable(const SAbstractTable& a, const SAbstractTable& b) {
+  return a.code == b.code && a.alias == b.alias;
+}
+
+static bool isSameStructure(const SPresetTable& a, const SPresetTable& b) {
+  return isSameTable(a, b) && a.table == b.table;
+}
+
+static bool isSameStructure(const SSwitchKindTable& a, const SSwitchKindTable& b) {
+  return isSameTable(a, b) && a.table == b.table;
+}
+
+static bool isSameStructure(const SAudioElementKind& a, const SAudioElementKind& b) {
+  return isSameTable(a, b) && a.table == b.table && a.langCode == b.langCode;
+}
+
+template <typename T>
+static bool isSameStructure(const T& a, const T& b) {
+  // range properties (prominence level, azimuth and elevation)
+  return a.isActionAllowed == b.isActionAllowed && a.valueSlot == b.valueSlot &&
+         a.minValue == b.minValue && a.maxValue == b.maxValue && a.defaultValue == b.defaultValue;
+}
+
+static bool isSameStructure(const SMutingProperty& a, const SMutingProperty& b) {
+  return a.isActionAllowed == b.isActionAllowed && a.valueSlot == b.valueSlot &&
+         a.defaultValue == b.defaultValue;
+}
+
+template <typename T>
+static bool isSameElementStructure(const T& a, const T& b) {
+  return a.id == b.id && a.isAvailable == b.isAvailable &&
+         isSameStructure(a.prominence, b.prominence) && isSameStructure(a.muting, b.muting) &&
+         isSameStructure(a.azimuth, b.azimuth) && isSameStructure(a.elevation, b.elevation) &&
+         isSameStructure(a.kind, b.kind) && isSameStructure(a.customKind, b.customKind);
+}
+
+static bool isSameStructure(const SAudioElement& a, const SAudioElement& b) {
+  return isSameElementStructure(a, b);
+}
+
+static bool isSameStructure(const SAudioElementSwitchItem& a, const SAudioElementSwitchItem& b) {
+  return a.id == b.id && a.isActiveSlot == b.isActiveSlot && a.isAvailable == b.isAvailable &&
+         a.isSelectable == b.isSelectable && a.isDefault == b.isDefault &&
+         isSameStructure(a.kind, b.kind) && isSameStructure(a.customKind, b.customKind);
+}
+
+static bool isSameStructure(const SAudioElementSwitch& a, const SAudioElementSwitch& b) {
+  return isSameElementStructure(a, b) && a.isActionAllowed == b.isActionAllowed &&
+         isSameStructure(a.audioElements, b.audioElements);
+}
+
+static bool isSameStructure(const SPreset& a, const SPreset& b) {
+  return a.id == b.id && a.isActiveSlot == b.isActiveSlot && a.isAvailable == b.isAvailable &&
+         a.isDefault == b.isDefault && isSameStructure(a.kind, b.kind) &&
+         isSameStructure(a.customKind, b.customKind) &&
+         isSameStructure(a.audioElements, b.audioElements) &&
+         isSameStructure(a.switchGroups, b.switchGroups);
+}
+
+/*!
+ * Compares everything except the current values and the lookup tables of the given configs.
+ */
+static bool isSameStructure(const SAudioSceneConfig& a, const SAudioSceneConfig& b) {
+  return a.uuid == b.uuid && a.version == b.version &&
+         a.drcInfo.availableEffects == b.drcInfo.availableEffects &&
+         isSameStructure(a.presets, b.presets) &&
+         isSameStructure(a.audioElements, b.audioElements) &&
+         isSameStructure(a.switchGroups, b.switchGroups);
+}
+
+////
+// Process-wide cache of the shared AudioScene structures
+////
+
+struct SSceneCacheShard {
+  std::mutex lock;
+  // Keyed by the structure hash, which includes the UUID
+  std::unordered_multimap<std::size_t, std::weak_ptr<const SAudioSceneConfig>> scenes;
+  // Number of insertions since the expired entries were last removed
+  std::size_t numInsertions = 0;
+};
+
+static constexpr std::size_t NUM_SCENE_CACHE_SHARDS = 16;
+static SSceneCacheShard SCENE_CACHE[NUM_SCENE_CACHE_SHARDS];
+
+// Estimated memory of all shared structures which are still referenced by any translator
+static std::atomic<std::size_t> SHARED_MEMORY_BYTES{0};
+
+/*!
+ * Deleter of the shared structures, which releases their memory from the accounted total.
+ */
+struct SSharedAudioSceneDeleter {
+  std::size_t memoryBytes;
+
+  void operator()(const SAudioSceneConfig* config) const {
+    SHARED_MEMORY_BYTES.fetch_sub(memoryBytes);
+    delete config;
+  }
+};
+
+/*!
+ * Returns the shared structure identical to the given one from the given shard, if any. The shard
+ * lock needs to be held by the caller.
+ */
+static std::shared_ptr<const SAudioSceneConfig> findSharedAudioScene(
+    SSceneCacheShard& shard, std::size_t hash, const SAudioSceneConfig& asi) {
+  auto range = shard.scenes.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    auto config = it->second.lock();
+    if (config && isSameStructure(*config, asi)) {
+      return config;
+    }
+  }
+  return nullptr;
+}
+
+/*!
+ * Removes all entries of the given shard which are not referenced by any translator anymore. The
+ * shard lock needs to be held by the caller.
+ */
+static void removeExpiredAudioScenes(SSceneCacheShard& shard) {
+  for (auto it = shard.scenes.begin(); it != shard.scenes.end();) {
+    if (it->second.expired()) {
+      it = shard.scenes.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  shard.numInsertions = 0;
+}
+
+std::shared_ptr<const SAudioSceneConfig> internAudioScene(SAudioSceneConfig asi) {
+  auto hash = hashStructure(asi);
+  auto& shard = SCENE_CACHE[hash % NUM_SCENE_CACHE_SHARDS];
+
+  {
+    std::lock_guard<std::mutex> guard{shard.lock};
+    if (auto config = findSharedAudioScene(shard, hash, asi)) {
+      return config;
+    }
+  }
+
+  // Build the lookup tables outside of the lock, so that other structures can be looked up in the
+  // meantime. The tables point into the config, so they are built at its final location.
+  std::unique_ptr<SAudioSceneConfig> shared{new SAudioSceneConfig(std::move(asi))};
+  shared->index = std::make_shared<SAudioSceneIndex>(buildAudioSceneIndex(*shared));
+  auto memoryBytes = estimateMemoryUsage(*shared);
+
+  std::lock_guard<std::mutex> guard{shard.lock};
+  if (auto existingConfig = findSharedAudioScene(shard, hash, *shared)) {
+    // interned by another translator in the meantime
+    return existingConfig;
+  }
+  SHARED_MEMORY_BYTES.fetch_add(memoryBytes);
+  std::shared_ptr<const SAudioSceneConfig> config{shared.release(),
+                                                  SSharedAudioSceneDeleter{memoryBytes}};
+  // Amortize the removal of expired entries over the insertions
+  if (++shard.numInsertions > shard.scenes.size()) {
+    removeExpiredAudioScenes(shard);
+  }
+  shard.scenes.emplace(hash, config);
+  return config;
+}
+
+std::shared_ptr<const SAudioSceneConfig> parseSharedAudioScene(const std::string& audioSceneXml,
+                                                               SAudioSceneValues& outValues,
+                                                               STranslatorCounters* counters) {
+  std::unique_ptr<SXmlString> xml;
+  {
+    CStageTimer timer{counters, STAGE_XML_PARSE};
+    xml.reset(new SXmlString(audioSceneXml));
+  }
+
+  CStageTimer timer{counters, STAGE_MODEL_BUILD};
+  outValues.values.clear();
+  auto asi = parseAudioScene(xml->getRoot(), outValues);
+  xml.reset();
+  return internAudioScene(std::move(asi));
+}
+
+std::size_t getSharedAudioSceneMemoryUsage() { return SHARED_MEMORY_BYTES.load(); }
+
+std::size_t getSharedAudioSceneMemoryUsage(const std::shared_ptr<const SAudioSceneConfig>& config) {
+  // The estimate of an interned structure is kept in its deleter, see internAudioScene()
+  if (auto deleter = std::get_deleter<SSharedAudioSceneDeleter>(config)) {
+    return deleter->memoryBytes;
+  }
+  return estimateMemoryUsage(*config);
+}
+
+}  // namespace mpeghuitranslator
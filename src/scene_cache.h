@@ -0,0 +1,134 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#pragma once
+
+// Internal headers
+#include "audio_scene.h"
+#include "statistics.h"
+
+// System headers
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace mpeghuitranslator {
+
+/*!
+ * Parses the given AudioScene XML into the shared structure (see #internAudioScene()) and the
+ * current values of the AudioScene, which are written into the given values.
+ *
+ * Translators receiving AudioScenes which only differ in their current values, e.g. the same
+ * programme with different user interactivity, therefore only hold a private copy of the current
+ * values. The XML is always parsed, since the current values may differ with every call. The given
+ * values are overwritten and keep their capacity, so that a reused value block is not allocated
+ * again.
+ *
+ * The XML parse and model build stages are measured with the given counters, if not NULL.
+ */
+std::shared_ptr<const SAudioSceneConfig> parseSharedAudioScene(
+    const std::string& audioSceneXml, SAudioSceneValues& outValues,
+    STranslatorCounters* counters = nullptr);
+
+/*!
+ * Returns the process-wide shared instance of the given AudioScene structure.
+ *
+ * The structures are interned by their UUID and a hash of their structure, i.e. everything except
+ * the current values, for as long as at least one translator references them. Structures with an
+ * equal hash are compared field by field, the AudioScene XML they were parsed from is not retained.
+ * The lookup tables of a structure (see scene_index.h) are built once when it is interned.
+ */
+std::shared_ptr<const SAudioSceneConfig> internAudioScene(SAudioSceneConfig asi);
+
+/*!
+ * Returns an estimate of the memory in bytes occupied by all interned AudioScene structures,
+ * including their lookup tables.
+ */
+std::size_t getSharedAudioSceneMemoryUsage();
+
+/*!
+ * Returns an estimate of the memory in bytes occupied by the given AudioScene structure, including
+ * its lookup tables. The estimate of an interned structure is not computed again.
+ */
+std::size_t getSharedAudioSceneMemoryUsage(const std::shared_ptr<const SAudioSceneConfig>& config);
+
+}  // namespace mpeghuitranslator
@@ -108,6 +108,11 @@ struct SValueChange {
   explicit SValueChange(const T& val) : newValue(val), isChanged(true) {}
   explicit SValueChange(T&& val) : newValue(std::move(val)), isChanged(true) {}
 
+  void set(const T& val) {
+    newValue = val;
+    isChanged = true;
+  }
+
   void set(T&& val) {
     newValue = std::move(val);
     isChanged = true;
@@ -162,18 +167,55 @@ struct SAudioSceneChanges {
   std::vector<SPresetChanges> presets;
 };
 
+/*!
+ * Action types of the MPEG-H UI manager ActionEvents generated by this library.
+ */
+enum EActionType {
+  ACTION_PRESET_SELECTED = 30,
+  ACTION_AUDIO_ELEMENT_MUTING_CHANGED = 40,
+  ACTION_AUDIO_ELEMENT_PROMINENCE_LEVEL_CHANGED = 41,
+  ACTION_AUDIO_ELEMENT_AZIMUTH_CHANGED = 42,
+  ACTION_AUDIO_ELEMENT_ELEVATION_CHANGED = 43,
+  ACTION_AUDIO_ELEMENT_SWITCH_SELECTED = 60,
+  ACTION_AUDIO_ELEMENT_SWITCH_MUTING_CHANGED = 61,
+  ACTION_AUDIO_ELEMENT_SWITCH_PROMINENCE_LEVEL_CHANGED = 62,
+  ACTION_AUDIO_ELEMENT_SWITCH_AZIMUTH_CHANGED = 63,
+  ACTION_AUDIO_ELEMENT_SWITCH_ELEVATION_CHANGED = 64,
+  ACTION_INTERFACE_LANGUAGE_SELECTED = 71,
+};
+
+/*!
+ * Plain representation of a single MPEG-H UI manager ActionEvent.
+ *
+ * Only the parameters marked as changed are part of the ActionEvent.
+ */
+struct SActionEvent {
+  int actionType;
+  SUuid uuid;
+  SValueChange<std::string> paramText;
+  SValueChange<int> paramInt;
+  SValueChange<double> paramFloat;
+  // ID of the selected item of ACTION_AUDIO_ELEMENT_SWITCH_SELECTED events, which is transmitted
+  // in the paramFloat parameter of the ActionEvent
+  SValueChange<int> selectedItemId;
+  SValueChange<bool> paramBool;
+};
+
 /*!
  * Parses and transforms the given JSON object conforming to the proposed JSON format for
  * application standards in the json_schema/ project folder into a collection of changes to an
  * MPEG-H UI manager AudioScene represented by the JSON values.
+ *
+ * If validateSchema is set, the JSON object is also validated against the json_schema/POST schemas
+ * in the same pass and an std::invalid_argument exception is thrown for the first violation.
  */
-SAudioSceneChanges parseAudioSceneChanges(const Json::Value& json);
+SAudioSceneChanges parseAudioSceneChanges(const Json::Value& json, bool validateSchema = false);
 
 /*!
  * Converts the given list of changes to the AudioScene to a list of XML strings containing the
  * MPEG-H UI manager ActionEvents to apply to effect the given changes.
  *
- * If the baseAsi parameter is not set (NULL), only "global" ActionEvents are generated,
+ * If the baseScene parameter is not set (NULL), only "global" ActionEvents are generated,
  * which do not affect a specific AudioScene or its object.
  *
  * If the baseDisplayLanguageCode parameters is not set (NULL), the current display language is
@@ -181,7 +223,35 @@ SAudioSceneChanges parseAudioSceneChanges(const Json::Value& json);
  * generating an ActionEvent if the display language in the sceneChanges is "changed".
  */
 std::vector<std::string> composeActionEvents(const SAudioSceneChanges& sceneChanges,
-                                             const SAudioSceneConfig* baseAsi,
+                                             const SAudioScene* baseScene,
                                              const std::string* baseDisplayLanguageCode);
 
+/*!
+ * Same as composeActionEvents(), but returns the plain ActionEvent values instead of composing the
+ * XML strings.
+ */
+std::vector<SActionEvent> collectActionEvents(const SAudioSceneChanges& sceneChanges,
+                                              const SAudioScene* baseScene,
+                                              const std::string* baseDisplayLanguageCode);
+
+/*!
+ * Same as collectActionEvents(), but writes the ActionEvents into the given vector. The elements
+ * already contained in the vector are reused, so that collecting the events of similar scene
+ * changes repeatedly does not allocate memory.
+ */
+void collectActionEvents(const SAudioSceneChanges& sceneChanges, const SAudioScene* baseScene,
+                         const std::string* baseDisplayLanguageCode,
+                         std::vector<SActionEvent>& outEvents);
+
+/*!
+ * Composes the MPEG-H UI manager ActionEvent XML string for the given ActionEvent.
+ */
+std::string composeActionEvent(const SActionEvent& event);
+
+/*!
+ * Same as composeActionEvent(const SActionEvent&), but assigns the XML string to the given output
+ * string, reusing its capacity.
+ */
+void composeActionEvent(const SActionEvent& event, std::string& outXml);
+
 }  // namespace mpeghuitranslator
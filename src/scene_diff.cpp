@@ -0,0 +1,460 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// Internal headers
+#include "scene_diff.h"
+
+// System headers
+#include <algorithm>
+
+namespace mpeghuitranslator {
+
+////
+// AudioScene diff
+////
+
+template <typename T>
+static const T* findById(const std::vector<T>& list, int id) {
+  auto it = std::find_if(list.begin(), list.end(), [id](const T& entry) { return entry.id == id; });
+  if (it != list.end()) {
+    return &*it;
+  }
+  return nullptr;
+}
+
+/*!
+ * Current values of the two compared AudioScenes and the collected differences.
+ */
+struct SDiffContext {
+  const SAudioSceneValues& oldValues;
+  const SAudioSceneValues& newValues;
+  SAudioSceneDiff& diff;
+  SConfigChange& config;
+};
+
+template <typename T>
+static int getActiveId(const std::vector<T>& list, const SAudioSceneValues& values) {
+  auto it = std::find_if(list.begin(), list.end(),
+                         [&values](const T& entry) { return isActive(values, entry); });
+  if (it != list.end()) {
+    return it->id;
+  }
+  return -1;
+}
+
+template <typename T>
+static float getCurrentValue(const std::unique_ptr<T>& property, const SAudioSceneValues& values) {
+  return property ? getCurrentValue(values, *property) : 0.0f;
+}
+
+template <typename T>
+static bool isValueChanged(const std::unique_ptr<T>& oldProperty,
+                           const std::unique_ptr<T>& newProperty, const SDiffContext& context) {
+  return oldProperty && newProperty &&
+         getCurrentValue(context.oldValues, *oldProperty) !=
+             getCurrentValue(context.newValues, *newProperty);
+}
+
+template <typename T>
+static bool isSameLimits(const T& oldProperty, const T& newProperty) {
+  return oldProperty.isActionAllowed == newProperty.isActionAllowed &&
+         oldProperty.minValue == newProperty.minValue &&
+         oldProperty.maxValue == newProperty.maxValue &&
+         oldProperty.defaultValue == newProperty.defaultValue;
+}
+
+static bool isSameLimits(const SMutingProperty& oldProperty, const SMutingProperty& newProperty) {
+  return oldProperty.isActionAllowed == newProperty.isActionAllowed &&
+         oldProperty.defaultValue == newProperty.defaultValue;
+}
+
+static bool isSameKind(const SAbstractTable& oldKind, const SAbstractTable& newKind) {
+  return oldKind.code == newKind.code;
+}
+
+static bool isSameKind(const SAudioElementKind& oldKind, const SAudioElementKind& newKind) {
+  return oldKind.code == newKind.code && oldKind.langCode == newKind.langCode;
+}
+
+static bool isSameKind(const SCustomDescriptor&, const SCustomDescriptor&) { return true; }
+
+static bool isSameKind(const SCustomAudioElementKind& oldKind,
+                       const SCustomAudioElementKind& newKind) {
+  return oldKind.langCode == newKind.langCode;
+}
+
+/*!
+ * Compares the parts of the given optional properties or kinds which are not current values.
+ */
+template <typename T>
+static bool isSameStructure(const std::unique_ptr<T>& oldValue,
+                            const std::unique_ptr<T>& newValue) {
+  if (!oldValue || !newValue) {
+    return !oldValue && !newValue;
+  }
+  return isSameLimits(*oldValue, *newValue);
+}
+
+template <typename T>
+static bool isSameKind(const std::unique_ptr<T>& oldKind, const std::unique_ptr<T>& newKind) {
+  if (!oldKind || !newKind) {
+    return !oldKind && !newKind;
+  }
+  return isSameKind(*oldKind, *newKind);
+}
+
+template <typename T>
+static bool isSameLabels(const std::unique_ptr<T>& oldKind, const std::unique_ptr<T>& newKind) {
+  if (!oldKind || !newKind) {
+    return !oldKind && !newKind;
+  }
+  const auto& oldLabels = oldKind->description;
+  const auto& newLabels = newKind->description;
+  return oldLabels.size() == newLabels.size() &&
+         std::equal(oldLabels.begin(), oldLabels.end(), newLabels.begin(),
+                    [](const SLocalizedString& oldLabel, const SLocalizedString& newLabel) {
+                      return oldLabel.langCode == newLabel.langCode &&
+                             oldLabel.value == newLabel.value;
+                    });
+}
+
+/*!
+ * Reports the changes of the current values and the structure shared by audio elements and switch
+ * groups.
+ */
+template <typename T>
+static void diffElementProperties(const SElementRef& ref, const T& oldElement, const T& newElement,
+                                  SDiffContext& context) {
+  auto& config = context.config;
+  auto& diff = context.diff;
+  if (oldElement.isAvailable != newElement.isAvailable ||
+      !isSameStructure(oldElement.prominence, newElement.prominence) ||
+      !isSameStructure(oldElement.muting, newElement.muting) ||
+      !isSameStructure(oldElement.azimuth, newElement.azimuth) ||
+      !isSameStructure(oldElement.elevation, newElement.elevation) ||
+      !isSameKind(oldElement.kind, newElement.kind) ||
+      !isSameKind(oldElement.customKind, newElement.customKind)) {
+    config.isStructureChanged = true;
+  }
+  if (!isSameLabels(oldElement.customKind, newElement.customKind)) {
+    config.isLabelsChanged = true;
+  }
+
+  const auto& oldValues = context.oldValues;
+  const auto& newValues = context.newValues;
+  if (isValueChanged(oldElement.prominence, newElement.prominence, context)) {
+    diff.prominenceChanges.push_back(
+        SProminenceChange{ref, getCurrentValue(oldValues, *oldElement.prominence),
+                          getCurrentValue(newValues, *newElement.prominence)});
+  }
+  if (isValueChanged(oldElement.muting, newElement.muting, context)) {
+    diff.mutingChanges.push_back(SMutingChange{ref, getCurrentValue(oldValues, *oldElement.muting),
+                                               getCurrentValue(newValues, *newElement.muting)});
+  }
+  if (isValueChanged(oldElement.azimuth, newElement.azimuth, context) ||
+      isValueChanged(oldElement.elevation, newElement.elevation, context)) {
+    diff.positionChanges.push_back(SPositionChange{
+        ref, getCurrentValue(oldElement.azimuth, oldValues),
+        getCurrentValue(newElement.azimuth, newValues),
+        getCurrentValue(oldElement.elevation, oldValues),
+        getCurrentValue(newElement.elevation, newValues)});
+  }
+}
+
+static void diffAudioElement(int presetId, const SAudioElement& oldElement,
+                             const SAudioElement& newElement, SDiffContext& context) {
+  diffElementProperties(SElementRef{presetId, newElement.id, false}, oldElement, newElement,
+                        context);
+}
+
+static void diffSwitchGroup(int presetId, const SAudioElementSwitch& oldSwitchGroup,
+                            const SAudioElementSwitch& newSwitchGroup, SDiffContext& context) {
+  auto& config = context.config;
+  diffElementProperties(SElementRef{presetId, newSwitchGroup.id, true}, oldSwitchGroup,
+                        newSwitchGroup, context);
+  if (oldSwitchGroup.isActionAllowed != newSwitchGroup.isActionAllowed ||
+      oldSwitchGroup.audioElements.size() != newSwitchGroup.audioElements.size()) {
+    config.isStructureChanged = true;
+  }
+
+  for (const auto& newItem : newSwitchGroup.audioElements) {
+    const auto* oldItem = findById(oldSwitchGroup.audioElements, newItem.id);
+    if (!oldItem) {
+      config.isStructureChanged = true;
+      continue;
+    }
+    if (oldItem->isAvailable != newItem.isAvailable ||
+        oldItem->isSelectable != newItem.isSelectable ||
+        oldItem->isDefault != newItem.isDefault || !isSameKind(oldItem->kind, newItem.kind) ||
+        !isSameKind(oldItem->customKind, newItem.customKind)) {
+      config.isStructureChanged = true;
+    }
+    if (!isSameLabels(oldItem->customKind, newItem.customKind)) {
+      config.isLabelsChanged = true;
+    }
+  }
+
+  auto oldItemId = getActiveId(oldSwitchGroup.audioElements, context.oldValues);
+  auto newItemId = getActiveId(newSwitchGroup.audioElements, context.newValues);
+  if (oldItemId != newItemId) {
+    context.diff.switchGroupSelections.push_back(
+        SSwitchGroupSelectionChange{presetId, newSwitchGroup.id, oldItemId, newItemId});
+  }
+}
+
+template <typename T, typename DiffEntry>
+static void diffList(int presetId, const std::vector<T>& oldList, const std::vector<T>& newList,
+                     SDiffContext& context, DiffEntry diffEntry) {
+  if (oldList.size() != newList.size()) {
+    context.config.isStructureChanged = true;
+  }
+  for (const auto& newEntry : newList) {
+    if (const auto* oldEntry = findById(oldList, newEntry.id)) {
+      diffEntry(presetId, *oldEntry, newEntry, context);
+    } else {
+      context.config.isStructureChanged = true;
+    }
+  }
+}
+
+static void diffPreset(int, const SPreset& oldPreset, const SPreset& newPreset,
+                       SDiffContext& context) {
+  auto& config = context.config;
+  if (oldPreset.isAvailable != newPreset.isAvailable ||
+      oldPreset.isDefault != newPreset.isDefault || !isSameKind(oldPreset.kind, newPreset.kind)) {
+    config.isStructureChanged = true;
+  }
+  if (!isSameLabels(oldPreset.customKind, newPreset.customKind)) {
+    config.isLabelsChanged = true;
+  }
+  diffList(newPreset.id, oldPreset.audioElements, newPreset.audioElements, context,
+           diffAudioElement);
+  diffList(newPreset.id, oldPreset.switchGroups, newPreset.switchGroups, context, diffSwitchGroup);
+}
+
+SAudioSceneDiff diffAudioScenes(const SAudioScene* oldScene, const SAudioScene& newScene) {
+  SAudioSceneDiff diff;
+  const auto& newAsi = *newScene.config;
+  auto newPresetId = getActiveId(newAsi.presets, newScene.values);
+  if (!oldScene) {
+    if (newPresetId != -1) {
+      diff.presetActivations.push_back(SPresetActivationChange{-1, newPresetId});
+    }
+    diff.configChanges.push_back(SConfigChange{"", newAsi.uuid, true, true});
+    return diff;
+  }
+
+  const auto& oldAsi = *oldScene->config;
+  auto oldPresetId = getActiveId(oldAsi.presets, oldScene->values);
+  if (oldPresetId != newPresetId) {
+    diff.presetActivations.push_back(SPresetActivationChange{oldPresetId, newPresetId});
+  }
+
+  SConfigChange config{oldAsi.uuid, newAsi.uuid, false, false};
+  if (oldAsi.version != newAsi.version ||
+      oldAsi.drcInfo.availableEffects != newAsi.drcInfo.availableEffects) {
+    config.isStructureChanged = true;
+  }
+  SDiffContext context{oldScene->values, newScene.values, diff, config};
+  diffList(-1, oldAsi.presets, newAsi.presets, context, diffPreset);
+  diffList(-1, oldAsi.audioElements, newAsi.audioElements, context, diffAudioElement);
+  diffList(-1, oldAsi.switchGroups, newAsi.switchGroups, context, diffSwitchGroup);
+
+  if (config.oldUuid != config.newUuid || config.isStructureChanged || config.isLabelsChanged) {
+    diff.configChanges.push_back(std::move(config));
+  }
+  return diff;
+}
+
+////
+// Subscriptions
+////
+
+template <typename T>
+SubscriptionId CSubscriptionList::addEntry(Entries<T> SSubscriptions::*entries, T callback) {
+  std::lock_guard<std::mutex> guard{m_lock};
+  std::unique_ptr<SSubscriptions> subscriptions{
+      m_subscriptions ? new SSubscriptions(*m_subscriptions) : new SSubscriptions()};
+  auto id = m_nextId++;
+  ((*subscriptions).*entries).emplace_back(id, std::move(callback));
+  m_subscriptions = std::move(subscriptions);
+  return id;
+}
+
+SubscriptionId CSubscriptionList::add(PresetActivationCallback callback) {
+  return addEntry(&SSubscriptions::presetActivation, std::move(callback));
+}
+
+SubscriptionId CSubscriptionList::add(ProminenceCallback callback) {
+  return addEntry(&SSubscriptions::prominence, std::move(callback));
+}
+
+SubscriptionId CSubscriptionList::add(MutingCallback callback) {
+  return addEntry(&SSubscriptions::muting, std::move(callback));
+}
+
+SubscriptionId CSubscriptionList::add(PositionCallback callback) {
+  return addEntry(&SSubscriptions::position, std::move(callback));
+}
+
+SubscriptionId CSubscriptionList::add(SwitchGroupSelectionCallback callback) {
+  return addEntry(&SSubscriptions::switchGroupSelection, std::move(callback));
+}
+
+SubscriptionId CSubscriptionList::add(ConfigChangeCallback callback) {
+  return addEntry(&SSubscriptions::configChange, std::move(callback));
+}
+
+template <typename T>
+static bool removeEntry(std::vector<std::pair<SubscriptionId, T>>& entries, SubscriptionId id) {
+  auto it = std::find_if(
+      entries.begin(), entries.end(),
+      [id](const std::pair<SubscriptionId, T>& entry) { return entry.first == id; });
+  if (it == entries.end()) {
+    return false;
+  }
+  entries.erase(it);
+  return true;
+}
+
+bool CSubscriptionList::remove(SubscriptionId id) {
+  std::lock_guard<std::mutex> guard{m_lock};
+  if (!m_subscriptions) {
+    return false;
+  }
+  std::unique_ptr<SSubscriptions> subscriptions{new SSubscriptions(*m_subscriptions)};
+  bool isRemoved = removeEntry(subscriptions->presetActivation, id) ||
+                   removeEntry(subscriptions->prominence, id) ||
+                   removeEntry(subscriptions->muting, id) ||
+                   removeEntry(subscriptions->position, id) ||
+                   removeEntry(subscriptions->switchGroupSelection, id) ||
+                   removeEntry(subscriptions->configChange, id);
+  if (isRemoved) {
+    m_subscriptions = std::move(subscriptions);
+  }
+  return isRemoved;
+}
+
+std::shared_ptr<const CSubscriptionList::SSubscriptions> CSubscriptionList::load() const {
+  std::lock_guard<std::mutex> guard{m_lock};
+  return m_subscriptions;
+}
+
+bool CSubscriptionList::isEmpty() const {
+  auto subscriptions = load();
+  return !subscriptions ||
+         (subscriptions->presetActivation.empty() && subscriptions->prominence.empty() &&
+          subscriptions->muting.empty() && subscriptions->position.empty() &&
+          subscriptions->switchGroupSelection.empty() && subscriptions->configChange.empty());
+}
+
+template <typename T, typename C>
+static void notifyEntries(const std::vector<std::pair<SubscriptionId, T>>& entries,
+                          const std::vector<C>& changes) {
+  if (changes.empty()) {
+    return;
+  }
+  for (const auto& entry : entries) {
+    for (const auto& change : changes) {
+      try {
+        entry.second(change);
+      } catch (...) {
+        // A failing subscriber must neither affect the translation nor the other subscribers
+      }
+    }
+  }
+}
+
+void CSubscriptionList::notify(const SAudioSceneDiff& diff) const {
+  auto subscriptions = load();
+  if (!subscriptions) {
+    return;
+  }
+  notifyEntries(subscriptions->configChange, diff.configChanges);
+  notifyEntries(subscriptions->presetActivation, diff.presetActivations);
+  notifyEntries(subscriptions->switchGroupSelection, diff.switchGroupSelections);
+  notifyEntries(subscriptions->prominence, diff.prominenceChanges);
+  notifyEntries(subscriptions->muting, diff.mutingChanges);
+  notifyEntries(subscriptions->position, diff.positionChanges);
+}
+
+}  // namespace mpeghuitranslator
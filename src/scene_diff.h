@@ -0,0 +1,171 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#pragma once
+
+// Internal headers
+#include "mpeghuitranslator/subscription.h"
+#include "audio_scene.h"
+
+// System headers
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mpeghuitranslator {
+
+/*!
+ * All differences between two consecutive AudioScenes of a translator, grouped by change type.
+ */
+struct SAudioSceneDiff {
+  std::vector<SPresetActivationChange> presetActivations;
+  std::vector<SProminenceChange> prominenceChanges;
+  std::vector<SMutingChange> mutingChanges;
+  std::vector<SPositionChange> positionChanges;
+  std::vector<SSwitchGroupSelectionChange> switchGroupSelections;
+  std::vector<SConfigChange> configChanges;
+};
+
+/*!
+ * Compares the given AudioScene against the previous one of the same translator, which is NULL for
+ * the first AudioScene.
+ *
+ * Audio elements, switch groups and presets are matched by their IDs. Value changes are only
+ * reported for entries and properties present in both AudioScenes, everything else is reported as
+ * structural config change. For the first AudioScene, only the config change and the activation of
+ * the active preset are reported.
+ */
+SAudioSceneDiff diffAudioScenes(const SAudioScene* oldScene, const SAudioScene& newScene);
+
+/*!
+ * Thread-safe list of the subscriptions of a translator.
+ *
+ * The list is replaced as a whole on every modification, so that notifying the subscribers never
+ * holds the lock while calling the callbacks. Callbacks may therefore (un)subscribe themselves.
+ */
+class CSubscriptionList {
+ public:
+  SubscriptionId add(PresetActivationCallback callback);
+  SubscriptionId add(ProminenceCallback callback);
+  SubscriptionId add(MutingCallback callback);
+  SubscriptionId add(PositionCallback callback);
+  SubscriptionId add(SwitchGroupSelectionCallback callback);
+  SubscriptionId add(ConfigChangeCallback callback);
+
+  /*!
+   * Removes the subscription with the given ID, returns false if there is none.
+   */
+  bool remove(SubscriptionId id);
+
+  bool isEmpty() const;
+
+  /*!
+   * Calls the callbacks of all subscriptions for the changes of their type in the given diff.
+   * Exceptions thrown by the callbacks are ignored.
+   */
+  void notify(const SAudioSceneDiff& diff) const;
+
+ private:
+  template <typename T>
+  using Entries = std::vector<std::pair<SubscriptionId, T>>;
+
+  struct SSubscriptions {
+    Entries<PresetActivationCallback> presetActivation;
+    Entries<ProminenceCallback> prominence;
+    Entries<MutingCallback> muting;
+    Entries<PositionCallback> position;
+    Entries<SwitchGroupSelectionCallback> switchGroupSelection;
+    Entries<ConfigChangeCallback> configChange;
+  };
+
+  template <typename T>
+  SubscriptionId addEntry(Entries<T> SSubscriptions::*entries, T callback);
+
+  std::shared_ptr<const SSubscriptions> load() const;
+
+  mutable std::mutex m_lock;
+  std::shared_ptr<const SSubscriptions> m_subscriptions;
+  SubscriptionId m_nextId = 1;
+};
+
+}  // namespace mpeghuitranslator
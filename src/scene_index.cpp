@@ -0,0 +1,147 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// Internal headers
+#include "scene_index.h"
+
+namespace mpeghuitranslator {
+
+template <typename T>
+static void addLabels(SAudioSceneIndex& index, EIndexedEntry entry, std::uint64_t key,
+                      const std::unique_ptr<T>& customKind) {
+  if (!customKind) {
+    return;
+  }
+  for (const auto& label : customKind->description) {
+    SLangCode langCode{};
+    if (toLangCode(label.langCode, langCode)) {
+      // The first label of a language wins
+      index.labels.emplace(SLabelKey{entry, key, langCode}, &label.value);
+    }
+  }
+}
+
+static void addAudioElements(SAudioSceneIndex& index, int presetId,
+                             const std::vector<SAudioElement>& elements) {
+  for (const auto& element : elements) {
+    auto key = getEntryKey(presetId, element.id);
+    index.audioElements.emplace(key, &element);
+    addLabels(index, EIndexedEntry::kAudioElement, key, element.customKind);
+  }
+}
+
+static void addSwitchGroups(SAudioSceneIndex& index, int presetId,
+                            const std::vector<SAudioElementSwitch>& switchGroups) {
+  for (const auto& switchGroup : switchGroups) {
+    auto key = getEntryKey(presetId, switchGroup.id);
+    index.switchGroups.emplace(key, &switchGroup);
+    addLabels(index, EIndexedEntry::kSwitchGroup, key, switchGroup.customKind);
+  }
+}
+
+SAudioSceneIndex buildAudioSceneIndex(const SAudioSceneConfig& asi) {
+  SAudioSceneIndex index;
+  for (const auto& preset : asi.presets) {
+    index.presets.emplace(preset.id, &preset);
+    addLabels(index, EIndexedEntry::kPreset, getEntryKey(-1, preset.id), preset.customKind);
+    addAudioElements(index, preset.id, preset.audioElements);
+    addSwitchGroups(index, preset.id, preset.switchGroups);
+  }
+  addAudioElements(index, -1, asi.audioElements);
+  addSwitchGroups(index, -1, asi.switchGroups);
+  return index;
+}
+
+template <typename K, typename V, typename H>
+static std::size_t estimateMemoryUsage(const std::unordered_map<K, V, H>& map) {
+  // Each node holds the entry and the pointer to the next node, plus one pointer per bucket
+  using Entry = typename std::unordered_map<K, V, H>::value_type;
+  return map.size() * (sizeof(Entry) + 2 * sizeof(void*)) + map.bucket_count() * sizeof(void*);
+}
+
+std::size_t estimateMemoryUsage(const SAudioSceneIndex& index) {
+  return sizeof(SAudioSceneIndex) + estimateMemoryUsage(index.presets) +
+         estimateMemoryUsage(index.audioElements) + estimateMemoryUsage(index.switchGroups) +
+         estimateMemoryUsage(index.labels);
+}
+
+}  // namespace mpeghuitranslator
@@ -0,0 +1,180 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#pragma once
+
+// Internal headers
+#include "audio_scene.h"
+
+// System headers
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace mpeghuitranslator {
+
+/*!
+ * Kind of an AudioScene entry carrying labels.
+ */
+enum class EIndexedEntry : std::uint8_t { kPreset, kAudioElement, kSwitchGroup };
+
+/*!
+ * ISO 639-2 3-letter language code of a label as fixed-size array, so that label lookups neither
+ * copy nor allocate the language code.
+ */
+using SLangCode = std::array<char, 3>;
+
+/*!
+ * Converts the given NUL-terminated language code, returns false if it is no 3-letter code.
+ */
+inline bool toLangCode(const char* langCode, SLangCode& outCode) noexcept {
+  for (std::size_t i = 0; i < outCode.size(); ++i) {
+    if (langCode[i] == '\0') {
+      return false;
+    }
+    outCode[i] = langCode[i];
+  }
+  return langCode[outCode.size()] == '\0';
+}
+
+inline bool toLangCode(const std::string& langCode, SLangCode& outCode) noexcept {
+  return langCode.size() == outCode.size() && toLangCode(langCode.c_str(), outCode);
+}
+
+struct SLabelKey {
+  EIndexedEntry entry;
+  std::uint64_t id;
+  SLangCode langCode;
+
+  bool operator==(const SLabelKey& other) const {
+    return entry == other.entry && id == other.id && langCode == other.langCode;
+  }
+};
+
+struct SLabelKeyHash {
+  std::size_t operator()(const SLabelKey& key) const {
+    std::uint64_t langCode = 0;
+    for (auto c : key.langCode) {
+      langCode = (langCode << 8) | static_cast<unsigned char>(c);
+    }
+    return std::hash<std::uint64_t>{}(key.id ^ (static_cast<std::uint64_t>(key.entry) << 62)) ^
+           std::hash<std::uint64_t>{}(langCode);
+  }
+};
+
+/*!
+ * Lookup tables of an AudioScene config for constant time queries of the current values without
+ * composing the JSON representation. The tables point into the config they were built for and
+ * are only valid as long as that config is alive and not modified. Since the tables only depend on
+ * the structure of the AudioScene, they are shared along with the config by all translators.
+ *
+ * Audio elements and switch groups are keyed by the combination of the preset ID and their own ID
+ * (see #getEntryKey()). Entries defined on the AudioScene level (version 9 of the AudioScene XML
+ * format) are keyed with preset ID -1, the queries resolve them for the currently active preset the
+ * same way scene changes do. Only labels with a 3-letter language code are indexed.
+ */
+struct SAudioSceneIndex {
+  std::unordered_map<int, const SPreset*> presets;
+  std::unordered_map<std::uint64_t, const SAudioElement*> audioElements;
+  std::unordered_map<std::uint64_t, const SAudioElementSwitch*> switchGroups;
+  std::unordered_map<SLabelKey, const std::string*, SLabelKeyHash> labels;
+};
+
+inline std::uint64_t getEntryKey(int presetId, int id) {
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(presetId)) << 32) |
+         static_cast<std::uint32_t>(id);
+}
+
+/*!
+ * Builds the lookup tables for the given AudioScene config.
+ */
+SAudioSceneIndex buildAudioSceneIndex(const SAudioSceneConfig& asi);
+
+/*!
+ * Returns an estimate of the memory in bytes occupied by the lookup tables of the given index.
+ */
+std::size_t estimateMemoryUsage(const SAudioSceneIndex& index);
+
+}  // namespace mpeghuitranslator
@@ -0,0 +1,640 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// Internal headers
+#include "scene_snapshot.h"
+
+// System headers
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace mpeghuitranslator {
+
+////
+// Flat snapshot records
+//
+// All records only consist of 4-byte members, so that they have no padding and stay 4-byte aligned
+// within the snapshot. Strings are stored without terminating NUL.
+////
+
+static const char SNAPSHOT_MAGIC[4] = {'M', 'U', 'I', 'S'};
+// Needs to be incremented on every change of the records below
+static const std::uint32_t SNAPSHOT_FORMAT_VERSION = 1;
+static const std::uint32_t SNAPSHOT_BYTE_ORDER_MARK = 0x01020304;
+
+enum ESnapshotFlags : std::uint32_t {
+  FLAG_ACTIVE = 1U << 0,
+  FLAG_AVAILABLE = 1U << 1,
+  FLAG_DEFAULT = 1U << 2,
+  FLAG_SELECTABLE = 1U << 3,
+  FLAG_ACTION_ALLOWED = 1U << 4,
+};
+
+// Reference to a string (count in bytes) or an array of records, relative to the snapshot start
+struct SFlatRef {
+  std::uint32_t offset;
+  std::uint32_t count;
+};
+
+struct SFlatProperty {
+  std::uint32_t isPresent;
+  std::uint32_t isActionAllowed;
+  float minValue;
+  float maxValue;
+  // Muting properties store their boolean values as 0.0 and 1.0
+  float currentValue;
+  float defaultValue;
+};
+
+struct SFlatKind {
+  std::uint32_t isPresent;
+  std::uint32_t code;
+  SFlatRef alias;
+  SFlatRef langCode;
+};
+
+struct SFlatLabel {
+  SFlatRef langCode;
+  SFlatRef value;
+};
+
+struct SFlatCustomKind {
+  std::uint32_t isPresent;
+  SFlatRef langCode;
+  SFlatRef labels;
+};
+
+struct SFlatAudioElement {
+  std::int32_t id;
+  std::uint32_t flags;
+  SFlatProperty prominence;
+  SFlatProperty muting;
+  SFlatProperty azimuth;
+  SFlatProperty elevation;
+  SFlatKind kind;
+  SFlatCustomKind customKind;
+};
+
+struct SFlatSwitchItem {
+  std::int32_t id;
+  std::uint32_t flags;
+  SFlatKind kind;
+  SFlatCustomKind customKind;
+};
+
+struct SFlatSwitchGroup {
+  std::int32_t id;
+  std::uint32_t flags;
+  SFlatProperty prominence;
+  SFlatProperty muting;
+  SFlatProperty azimuth;
+  SFlatProperty elevation;
+  SFlatRef items;
+  SFlatKind kind;
+  SFlatCustomKind customKind;
+};
+
+struct SFlatPreset {
+  std::int32_t id;
+  std::uint32_t flags;
+  SFlatKind kind;
+  SFlatCustomKind customKind;
+  SFlatRef audioElements;
+  SFlatRef switchGroups;
+};
+
+struct SFlatHeader {
+  char magic[4];
+  std::uint32_t formatVersion;
+  std::uint32_t byteOrderMark;
+  // Size of the complete snapshot in bytes
+  std::uint32_t size;
+  SFlatRef uuid;
+  SFlatRef version;
+  std::uint32_t configChanged;
+  SFlatRef drcEffects;
+  SFlatRef presets;
+  SFlatRef audioElements;
+  SFlatRef switchGroups;
+};
+
+static_assert(sizeof(SFlatProperty) == 6 * 4, "Flat records must not contain padding");
+static_assert(sizeof(SFlatAudioElement) == 2 * 4 + 4 * sizeof(SFlatProperty) +
+                                               sizeof(SFlatKind) + sizeof(SFlatCustomKind),
+              "Flat records must not contain padding");
+static_assert(sizeof(SFlatHeader) == 4 * 4 + 6 * sizeof(SFlatRef) + 4,
+              "Flat records must not contain padding");
+
+static std::uint32_t toFlags(bool value, ESnapshotFlags flag) { return value ? flag : 0U; }
+
+static bool hasFlag(std::uint32_t flags, ESnapshotFlags flag) { return (flags & flag) != 0U; }
+
+////
+// Serialization
+////
+
+class CSnapshotWriter {
+ public:
+  CSnapshotWriter(std::vector<std::uint8_t>& out, const SAudioSceneValues& values)
+      : m_out(out), m_start(out.size()), m_values(values) {}
+
+  // Current values of the serialized AudioScene
+  const SAudioSceneValues& values() const { return m_values; }
+
+  /*!
+   * Appends the given number of zeroed bytes at the next 4-byte aligned offset and returns that
+   * offset.
+   */
+  std::uint32_t allocate(std::size_t size) {
+    auto offset = (m_out.size() - m_start + 3U) & ~std::size_t{3U};
+    if (offset + size > std::numeric_limits<std::uint32_t>::max()) {
+      throw std::length_error{"AudioScene is too large for a snapshot"};
+    }
+    m_out.resize(m_start + offset + size);
+    return static_cast<std::uint32_t>(offset);
+  }
+
+  template <typename R>
+  void store(std::uint32_t offset, const R& record) {
+    std::memcpy(&m_out[m_start + offset], &record, sizeof(R));
+  }
+
+  SFlatRef writeString(const std::string& value) {
+    auto offset = allocate(value.size());
+    if (!value.empty()) {
+      std::memcpy(&m_out[m_start + offset], value.data(), value.size());
+    }
+    return SFlatRef{offset, static_cast<std::uint32_t>(value.size())};
+  }
+
+  /*!
+   * Writes the records of the given list converted by the given function as contiguous array. The
+   * conversion may write further strings and arrays, which are placed after the array.
+   */
+  template <typename R, typename T, typename F>
+  SFlatRef writeArray(const std::vector<T>& list, F toRecord) {
+    auto offset = allocate(list.size() * sizeof(R));
+    for (std::size_t i = 0; i < list.size(); ++i) {
+      R record = toRecord(*this, list[i]);
+      store(static_cast<std::uint32_t>(offset + i * sizeof(R)), record);
+    }
+    return SFlatRef{offset, static_cast<std::uint32_t>(list.size())};
+  }
+
+  std::size_t size() const { return m_out.size() - m_start; }
+
+ private:
+  std::vector<std::uint8_t>& m_out;
+  std::size_t m_start;
+  const SAudioSceneValues& m_values;
+};
+
+template <typename T>
+static SFlatProperty toFlatProperty(const CSnapshotWriter& writer,
+                                    const std::unique_ptr<T>& property) {
+  SFlatProperty result{};
+  if (property) {
+    result.isPresent = 1;
+    result.isActionAllowed = property->isActionAllowed ? 1 : 0;
+    result.minValue = property->minValue;
+    result.maxValue = property->maxValue;
+    result.currentValue = getCurrentValue(writer.values(), *property);
+    result.defaultValue = property->defaultValue;
+  }
+  return result;
+}
+
+static SFlatProperty toFlatProperty(const CSnapshotWriter& writer,
+                                    const std::unique_ptr<SMutingProperty>& property) {
+  SFlatProperty result{};
+  if (property) {
+    result.isPresent = 1;
+    result.isActionAllowed = property->isActionAllowed ? 1 : 0;
+    result.currentValue = getCurrentValue(writer.values(), *property) ? 1.0f : 0.0f;
+    result.defaultValue = property->defaultValue ? 1.0f : 0.0f;
+  }
+  return result;
+}
+
+static const SIso639Code NO_LANG_CODE;
+
+static const SIso639Code& getLangCode(const SAbstractTable&) { return NO_LANG_CODE; }
+static const SIso639Code& getLangCode(const SAudioElementKind& kind) { return kind.langCode; }
+static const SIso639Code& getLangCode(const SCustomDescriptor&) { return NO_LANG_CODE; }
+static const SIso639Code& getLangCode(const SCustomAudioElementKind& kind) {
+  return kind.langCode;
+}
+
+template <typename T>
+static SFlatKind toFlatKind(CSnapshotWriter& writer, const std::unique_ptr<T>& kind) {
+  SFlatKind result{};
+  if (kind) {
+    result.isPresent = 1;
+    result.code = kind->code;
+    result.alias = writer.writeString(kind->alias);
+    result.langCode = writer.writeString(getLangCode(*kind));
+  }
+  return result;
+}
+
+template <typename T>
+static SFlatCustomKind toFlatCustomKind(CSnapshotWriter& writer, const std::unique_ptr<T>& kind) {
+  SFlatCustomKind result{};
+  if (kind) {
+    result.isPresent = 1;
+    result.langCode = writer.writeString(getLangCode(*kind));
+    result.labels = writer.writeArray<SFlatLabel>(
+        kind->description, [](CSnapshotWriter& labelWriter, const SLocalizedString& label) {
+          SFlatLabel flatLabel{};
+          flatLabel.langCode = labelWriter.writeString(label.langCode);
+          flatLabel.value = labelWriter.writeString(label.value);
+          return flatLabel;
+        });
+  }
+  return result;
+}
+
+static SFlatAudioElement toFlatAudioElement(CSnapshotWriter& writer, const SAudioElement& element) {
+  SFlatAudioElement result{};
+  result.id = element.id;
+  result.flags = toFlags(element.isAvailable, FLAG_AVAILABLE);
+  result.prominence = toFlatProperty(writer, element.prominence);
+  result.muting = toFlatProperty(writer, element.muting);
+  result.azimuth = toFlatProperty(writer, element.azimuth);
+  result.elevation = toFlatProperty(writer, element.elevation);
+  result.kind = toFlatKind(writer, element.kind);
+  result.customKind = toFlatCustomKind(writer, element.customKind);
+  return result;
+}
+
+static SFlatSwitchItem toFlatSwitchItem(CSnapshotWriter& writer,
+                                        const SAudioElementSwitchItem& item) {
+  SFlatSwitchItem result{};
+  result.id = item.id;
+  result.flags = toFlags(isActive(writer.values(), item), FLAG_ACTIVE) |
+                 toFlags(item.isAvailable, FLAG_AVAILABLE) |
+                 toFlags(item.isSelectable, FLAG_SELECTABLE) |
+                 toFlags(item.isDefault, FLAG_DEFAULT);
+  result.kind = toFlatKind(writer, item.kind);
+  result.customKind = toFlatCustomKind(writer, item.customKind);
+  return result;
+}
+
+static SFlatSwitchGroup toFlatSwitchGroup(CSnapshotWriter& writer,
+                                          const SAudioElementSwitch& switchGroup) {
+  SFlatSwitchGroup result{};
+  result.id = switchGroup.id;
+  result.flags = toFlags(switchGroup.isAvailable, FLAG_AVAILABLE) |
+                 toFlags(switchGroup.isActionAllowed, FLAG_ACTION_ALLOWED);
+  result.prominence = toFlatProperty(writer, switchGroup.prominence);
+  result.muting = toFlatProperty(writer, switchGroup.muting);
+  result.azimuth = toFlatProperty(writer, switchGroup.azimuth);
+  result.elevation = toFlatProperty(writer, switchGroup.elevation);
+  result.items = writer.writeArray<SFlatSwitchItem>(switchGroup.audioElements, toFlatSwitchItem);
+  result.kind = toFlatKind(writer, switchGroup.kind);
+  result.customKind = toFlatCustomKind(writer, switchGroup.customKind);
+  return result;
+}
+
+static SFlatPreset toFlatPreset(CSnapshotWriter& writer, const SPreset& preset) {
+  SFlatPreset result{};
+  result.id = preset.id;
+  result.flags = toFlags(isActive(writer.values(), preset), FLAG_ACTIVE) |
+                 toFlags(preset.isAvailable, FLAG_AVAILABLE) |
+                 toFlags(preset.isDefault, FLAG_DEFAULT);
+  result.kind = toFlatKind(writer, preset.kind);
+  result.customKind = toFlatCustomKind(writer, preset.customKind);
+  result.audioElements =
+      writer.writeArray<SFlatAudioElement>(preset.audioElements, toFlatAudioElement);
+  result.switchGroups = writer.writeArray<SFlatSwitchGroup>(preset.switchGroups, toFlatSwitchGroup);
+  return result;
+}
+
+void serializeAudioScene(const SAudioScene& scene, std::vector<std::uint8_t>& out) {
+  const auto& asi = *scene.config;
+  CSnapshotWriter writer{out, scene.values};
+  auto headerOffset = writer.allocate(sizeof(SFlatHeader));
+
+  SFlatHeader header{};
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.formatVersion = SNAPSHOT_FORMAT_VERSION;
+  header.byteOrderMark = SNAPSHOT_BYTE_ORDER_MARK;
+  header.uuid = writer.writeString(asi.uuid);
+  header.version = writer.writeString(asi.version);
+  header.configChanged = scene.values.configChanged ? 1 : 0;
+  header.drcEffects = writer.writeArray<std::uint32_t>(
+      asi.drcInfo.availableEffects,
+      [](CSnapshotWriter&, std::uint32_t effect) { return effect; });
+  header.presets = writer.writeArray<SFlatPreset>(asi.presets, toFlatPreset);
+  header.audioElements =
+      writer.writeArray<SFlatAudioElement>(asi.audioElements, toFlatAudioElement);
+  header.switchGroups = writer.writeArray<SFlatSwitchGroup>(asi.switchGroups, toFlatSwitchGroup);
+  header.size = static_cast<std::uint32_t>(writer.size());
+  writer.store(headerOffset, header);
+}
+
+////
+// Deserialization
+////
+
+class CSnapshotReader {
+ public:
+  CSnapshotReader(const std::uint8_t* data, std::size_t size, SAudioSceneValues* values = nullptr)
+      : m_data(data), m_size(size), m_values(values) {}
+
+  /*!
+   * Appends the given current value to the restored values and returns its slot.
+   */
+  SValueSlot addValue(float value) const { return addCurrentValue(*m_values, value); }
+
+  void check(std::uint64_t offset, std::uint64_t size) const {
+    if (offset > m_size || size > m_size - offset) {
+      throw std::invalid_argument{"AudioScene snapshot is truncated or corrupt"};
+    }
+  }
+
+  template <typename R>
+  R load(std::uint64_t offset) const {
+    check(offset, sizeof(R));
+    R record;
+    // Copy instead of casting, since the snapshot memory may not be suitably aligned
+    std::memcpy(&record, m_data + offset, sizeof(R));
+    return record;
+  }
+
+  /*!
+   * Accounts the given number of decoded bytes. Strings and arrays of a valid snapshot never
+   * overlap, so decoding more bytes than the snapshot holds means that records share their
+   * strings or arrays, which could expand a small snapshot quadratically.
+   */
+  void charge(std::uint64_t size) const {
+    m_numDecodedBytes += size;
+    if (m_numDecodedBytes > m_size) {
+      throw std::invalid_argument{"AudioScene snapshot contains overlapping records"};
+    }
+  }
+
+  std::string readString(const SFlatRef& ref) const {
+    check(ref.offset, ref.count);
+    charge(ref.count);
+    return std::string(reinterpret_cast<const char*>(m_data + ref.offset), ref.count);
+  }
+
+  template <typename R, typename T, typename F>
+  void readArray(const SFlatRef& ref, std::vector<T>& out, F fromRecord) const {
+    check(ref.offset, static_cast<std::uint64_t>(ref.count) * sizeof(R));
+    charge(static_cast<std::uint64_t>(ref.count) * sizeof(R));
+    out.reserve(ref.count);
+    for (std::uint32_t i = 0; i < ref.count; ++i) {
+      out.push_back(fromRecord(*this, load<R>(ref.offset + std::uint64_t{i} * sizeof(R))));
+    }
+  }
+
+ private:
+  const std::uint8_t* m_data;
+  std::size_t m_size;
+  SAudioSceneValues* m_values;
+  // Bytes of all strings and arrays decoded so far, see charge()
+  mutable std::uint64_t m_numDecodedBytes = 0;
+};
+
+template <typename T>
+static std::unique_ptr<T> fromFlatProperty(const CSnapshotReader& reader,
+                                           const SFlatProperty& flat) {
+  if (!flat.isPresent) {
+    return nullptr;
+  }
+  std::unique_ptr<T> result{new T()};
+  result->isActionAllowed = flat.isActionAllowed != 0;
+  result->minValue = flat.minValue;
+  result->maxValue = flat.maxValue;
+  result->valueSlot = reader.addValue(flat.currentValue);
+  result->defaultValue = flat.defaultValue;
+  return result;
+}
+
+template <>
+std::unique_ptr<SMutingProperty> fromFlatProperty<SMutingProperty>(const CSnapshotReader& reader,
+                                                                   const SFlatProperty& flat) {
+  if (!flat.isPresent) {
+    return nullptr;
+  }
+  std::unique_ptr<SMutingProperty> result{new SMutingProperty()};
+  result->isActionAllowed = flat.isActionAllowed != 0;
+  result->valueSlot = reader.addValue(flat.currentValue != 0.0f ? 1.0f : 0.0f);
+  result->defaultValue = flat.defaultValue != 0.0f;
+  return result;
+}
+
+static void setLangCode(SAbstractTable&, std::string) {}
+static void setLangCode(SAudioElementKind& kind, std::string langCode) {
+  kind.langCode = std::move(langCode);
+}
+static void setLangCode(SCustomDescriptor&, std::string) {}
+static void setLangCode(SCustomAudioElementKind& kind, std::string langCode) {
+  kind.langCode = std::move(langCode);
+}
+
+template <typename T>
+static std::unique_ptr<T> fromFlatKind(const CSnapshotReader& reader, const SFlatKind& flat) {
+  if (!flat.isPresent) {
+    return nullptr;
+  }
+  std::unique_ptr<T> result{new T()};
+  result->code = static_cast<std::uint8_t>(flat.code);
+  result->alias = reader.readString(flat.alias);
+  setLangCode(*result, reader.readString(flat.langCode));
+  return result;
+}
+
+template <typename T>
+static std::unique_ptr<T> fromFlatCustomKind(const CSnapshotReader& reader,
+                                             const SFlatCustomKind& flat) {
+  if (!flat.isPresent) {
+    return nullptr;
+  }
+  std::unique_ptr<T> result{new T()};
+  setLangCode(*result, reader.readString(flat.langCode));
+  reader.readArray<SFlatLabel>(
+      flat.labels, result->description,
+      [](const CSnapshotReader& labelReader, const SFlatLabel& label) {
+        return SLocalizedString{labelReader.readString(label.langCode),
+                                labelReader.readString(label.value)};
+      });
+  return result;
+}
+
+static SAudioElement fromFlatAudioElement(const CSnapshotReader& reader,
+                                          const SFlatAudioElement& flat) {
+  SAudioElement result{};
+  result.id = flat.id;
+  result.isAvailable = hasFlag(flat.flags, FLAG_AVAILABLE);
+  result.prominence = fromFlatProperty<SProminenceLevelProperty>(reader, flat.prominence);
+  result.muting = fromFlatProperty<SMutingProperty>(reader, flat.muting);
+  result.azimuth = fromFlatProperty<SAzimuthProperty>(reader, flat.azimuth);
+  result.elevation = fromFlatProperty<SElevationProperty>(reader, flat.elevation);
+  result.kind = fromFlatKind<SAudioElementKind>(reader, flat.kind);
+  result.customKind = fromFlatCustomKind<SCustomAudioElementKind>(reader, flat.customKind);
+  return result;
+}
+
+static SAudioElementSwitchItem fromFlatSwitchItem(const CSnapshotReader& reader,
+                                                  const SFlatSwitchItem& flat) {
+  SAudioElementSwitchItem result{};
+  result.id = flat.id;
+  result.isActiveSlot = reader.addValue(hasFlag(flat.flags, FLAG_ACTIVE) ? 1.0f : 0.0f);
+  result.isAvailable = hasFlag(flat.flags, FLAG_AVAILABLE);
+  result.isSelectable = hasFlag(flat.flags, FLAG_SELECTABLE);
+  result.isDefault = hasFlag(flat.flags, FLAG_DEFAULT);
+  result.kind = fromFlatKind<SAudioElementKind>(reader, flat.kind);
+  result.customKind = fromFlatCustomKind<SCustomAudioElementKind>(reader, flat.customKind);
+  return result;
+}
+
+static SAudioElementSwitch fromFlatSwitchGroup(const CSnapshotReader& reader,
+                                               const SFlatSwitchGroup& flat) {
+  SAudioElementSwitch result{};
+  result.id = flat.id;
+  result.isAvailable = hasFlag(flat.flags, FLAG_AVAILABLE);
+  result.isActionAllowed = hasFlag(flat.flags, FLAG_ACTION_ALLOWED);
+  result.prominence = fromFlatProperty<SProminenceLevelProperty>(reader, flat.prominence);
+  result.muting = fromFlatProperty<SMutingProperty>(reader, flat.muting);
+  result.azimuth = fromFlatProperty<SAzimuthProperty>(reader, flat.azimuth);
+  result.elevation = fromFlatProperty<SElevationProperty>(reader, flat.elevation);
+  reader.readArray<SFlatSwitchItem>(flat.items, result.audioElements, fromFlatSwitchItem);
+  result.kind = fromFlatKind<SSwitchKindTable>(reader, flat.kind);
+  result.customKind = fromFlatCustomKind<SCustomDescriptor>(reader, flat.customKind);
+  return result;
+}
+
+static SPreset fromFlatPreset(const CSnapshotReader& reader, const SFlatPreset& flat) {
+  SPreset result{};
+  result.id = flat.id;
+  result.isActiveSlot = reader.addValue(hasFlag(flat.flags, FLAG_ACTIVE) ? 1.0f : 0.0f);
+  result.isAvailable = hasFlag(flat.flags, FLAG_AVAILABLE);
+  result.isDefault = hasFlag(flat.flags, FLAG_DEFAULT);
+  result.kind = fromFlatKind<SPresetTable>(reader, flat.kind);
+  result.customKind = fromFlatCustomKind<SCustomDescriptor>(reader, flat.customKind);
+  reader.readArray<SFlatAudioElement>(flat.audioElements, result.audioElements,
+                                      fromFlatAudioElement);
+  reader.readArray<SFlatSwitchGroup>(flat.switchGroups, result.switchGroups, fromFlatSwitchGroup);
+  return result;
+}
+
+SAudioSceneConfig deserializeAudioScene(const void* data, std::size_t size,
+                                        SAudioSceneValues& outValues) {
+  if (data == nullptr || size < sizeof(SFlatHeader)) {
+    throw std::invalid_argument{"AudioScene snapshot is truncated or corrupt"};
+  }
+
+  CSnapshotReader headerReader{static_cast<const std::uint8_t*>(data), size};
+  auto header = headerReader.load<SFlatHeader>(0);
+  if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+    throw std::invalid_argument{"Data is no AudioScene snapshot"};
+  } else if (header.formatVersion != SNAPSHOT_FORMAT_VERSION) {
+    throw std::invalid_argument{"Unsupported AudioScene snapshot format version: " +
+                                std::to_string(header.formatVersion)};
+  } else if (header.byteOrderMark != SNAPSHOT_BYTE_ORDER_MARK) {
+    throw std::invalid_argument{"AudioScene snapshot was created with a different byte order"};
+  } else if (header.size > size) {
+    throw std::invalid_argument{"AudioScene snapshot is truncated or corrupt"};
+  }
+
+  CSnapshotReader reader{static_cast<const std::uint8_t*>(data), header.size, &outValues};
+  SAudioSceneConfig result{};
+  result.uuid = reader.readString(header.uuid);
+  result.version = reader.readString(header.version);
+  outValues.configChanged = header.configChanged != 0;
+  reader.readArray<std::uint32_t>(
+      header.drcEffects, result.drcInfo.availableEffects,
+      [](const CSnapshotReader&, std::uint32_t effect) { return effect; });
+  reader.readArray<SFlatPreset>(header.presets, result.presets, fromFlatPreset);
+  reader.readArray<SFlatAudioElement>(header.audioElements, result.audioElements,
+                                      fromFlatAudioElement);
+  reader.readArray<SFlatSwitchGroup>(header.switchGroups, result.switchGroups,
+                                     fromFlatSwitchGroup);
+  return result;
+}
+
+}  // namespace mpeghuitranslator
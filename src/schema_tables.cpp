@@ -0,0 +1,224 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// Internal headers
+#include "schema_tables.h"
+
+// External headers
+#include "json/json.h"
+
+// System headers
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace mpeghuitranslator {
+
+[[noreturn]] static void throwViolation(const SSchemaNode& node, const std::string& message) {
+  throw std::invalid_argument{"Scene changes JSON violates the schema at '" +
+                              std::string{node.name} + "': " + message};
+}
+
+static void validateBounds(const SSchemaNode& node, std::int64_t value, const char* what) {
+  if ((node.hasMinimum && value < node.minimum) || (node.hasMaximum && value > node.maximum)) {
+    throwViolation(node, std::string{what} + " " + std::to_string(value) + " is out of bounds");
+  }
+}
+
+static bool isUuid(const char* begin, const char* end) {
+  // As defined in RFC4122: hexadecimal values in the layout xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
+  if (end - begin != 36) {
+    return false;
+  }
+  for (const auto* it = begin; it != end; ++it) {
+    auto i = it - begin;
+    if (i == 8 || i == 13 || i == 18 || i == 23) {
+      if (*it != '-') {
+        return false;
+      }
+    } else if (!std::isxdigit(static_cast<unsigned char>(*it))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void validateArray(const SSchemaNode& node, const Json::Value& value) {
+  if (!value.isArray()) {
+    throwViolation(node, "value is not an array");
+  }
+  validateBounds(node, static_cast<std::int64_t>(value.size()), "array size");
+}
+
+void SSchemaPosition::validateValue(const Json::Value& value) const {
+  const auto& schemaNode = table->nodes[node];
+  switch (schemaNode.kind) {
+    case ESchemaNodeKind::kObject:
+      validateObjectMembers(value, {});
+      return;
+    case ESchemaNodeKind::kArray: {
+      validateArray(schemaNode, value);
+      SSchemaPosition items{table, schemaNode.first};
+      for (const auto& item : value) {
+        items.validateValue(item);
+      }
+      return;
+    }
+    case ESchemaNodeKind::kBoolean:
+      if (!value.isBool()) {
+        throwViolation(schemaNode, "value is not a boolean");
+      }
+      return;
+    case ESchemaNodeKind::kInteger:
+      if (!value.isInt64()) {
+        throwViolation(schemaNode, "value is not an integer");
+      }
+      validateBounds(schemaNode, value.asInt64(), "integer");
+      return;
+    case ESchemaNodeKind::kNumber:
+      if (!value.isNumeric()) {
+        throwViolation(schemaNode, "value is not a number");
+      }
+      return;
+    case ESchemaNodeKind::kString:
+    case ESchemaNodeKind::kUuid: {
+      const char* begin = nullptr;
+      const char* end = nullptr;
+      if (!value.isString() || !value.getString(&begin, &end)) {
+        throwViolation(schemaNode, "value is not a string");
+      }
+      if (schemaNode.kind == ESchemaNodeKind::kUuid && !isUuid(begin, end)) {
+        throwViolation(schemaNode, "string is not a UUID");
+      }
+      validateBounds(schemaNode, end - begin, "string length");
+      return;
+    }
+  }
+}
+
+void SSchemaPosition::validateObjectMembers(const Json::Value& value,
+                                            std::initializer_list<const char*> walkedArrays) const {
+  const auto& schemaNode = table->nodes[node];
+  if (!value.isObject()) {
+    throwViolation(schemaNode, "value is not an object");
+  }
+
+  // Additional members are allowed, since the schemas do not restrict "additionalProperties"
+  const auto* members = table->members + schemaNode.first;
+  for (std::size_t i = 0; i < schemaNode.numMembers; ++i) {
+    const auto& member = members[i];
+    const auto* memberValue = value.find(member.name, member.name + std::strlen(member.name));
+    if (!memberValue) {
+      if (member.isRequired) {
+        throwViolation(schemaNode, "required member '" + std::string{member.name} + "' is missing");
+      }
+      continue;
+    }
+
+    bool isWalked = false;
+    for (const auto* walkedArray : walkedArrays) {
+      isWalked = isWalked || std::strcmp(walkedArray, member.name) == 0;
+    }
+    if (isWalked) {
+      validateArray(table->nodes[member.node], *memberValue);
+    } else {
+      SSchemaPosition{table, member.node}.validateValue(*memberValue);
+    }
+  }
+}
+
+SSchemaPosition SSchemaPosition::findItems(const char* arrayMember) const {
+  const auto& schemaNode = table->nodes[node];
+  const auto* members = table->members + schemaNode.first;
+  for (std::size_t i = 0; i < schemaNode.numMembers; ++i) {
+    const auto& memberNode = table->nodes[members[i].node];
+    if (memberNode.kind == ESchemaNodeKind::kArray &&
+        std::strcmp(members[i].name, arrayMember) == 0) {
+      return SSchemaPosition{table, memberNode.first};
+    }
+  }
+  throw std::logic_error{"Schema '" + std::string{schemaNode.name} + "' has no array member '" +
+                         arrayMember + "'"};
+}
+
+}  // namespace mpeghuitranslator
@@ -0,0 +1,198 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#pragma once
+
+// External headers
+#include "json/forwards.h"
+
+// System headers
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace mpeghuitranslator {
+
+/*!
+ * Kind of JSON value described by a #SSchemaNode.
+ */
+enum class ESchemaNodeKind : std::uint8_t {
+  kObject,
+  kArray,
+  kBoolean,
+  kInteger,
+  kNumber,
+  kString,
+  kUuid,
+};
+
+/*!
+ * Single JSON value description of a JSON Schema, e.g. a whole schema file or an inline property.
+ */
+struct SSchemaNode {
+  ESchemaNodeKind kind;
+  // Schema $id or property name, for the error messages
+  const char* name;
+  // Index of the first member (kObject) or of the item node (kArray)
+  std::size_t first;
+  // Number of members (kObject)
+  std::size_t numMembers;
+  // Value bounds (kInteger), length bounds (kString) or size bounds (kArray)
+  bool hasMinimum;
+  std::int64_t minimum;
+  bool hasMaximum;
+  std::int64_t maximum;
+};
+
+/*!
+ * Property of a JSON object described by a #SSchemaNode of kind kObject.
+ */
+struct SSchemaMember {
+  const char* name;
+  std::size_t node;
+  bool isRequired;
+};
+
+/*!
+ * Tables of a set of JSON Schemas, generated at build time by cmake/GenerateSchemaTables.cmake.
+ */
+struct SSchemaTable {
+  const SSchemaNode* nodes;
+  const SSchemaMember* members;
+  std::size_t rootNode;
+};
+
+/*!
+ * Tables of the JSON Schemas in the json_schema/POST project folder.
+ */
+extern const SSchemaTable POST_SCHEMA_TABLE;
+
+/*!
+ * Position of a JSON value within a JSON Schema for the validation while parsing the value. A
+ * position without a table (the default) disables the validation.
+ *
+ * All validation functions throw an std::invalid_argument exception on the first violation of the
+ * schema.
+ */
+struct SSchemaPosition {
+  const SSchemaTable* table = nullptr;
+  std::size_t node = 0;
+
+  SSchemaPosition() = default;
+  SSchemaPosition(const SSchemaTable* schemaTable, std::size_t schemaNode) noexcept
+      : table(schemaTable), node(schemaNode) {}
+
+  /*!
+   * Validates the given JSON value and all its nested values.
+   */
+  void validate(const Json::Value& value) const {
+    if (table) {
+      validateValue(value);
+    }
+  }
+
+  /*!
+   * Validates the given JSON object and its members. The items of the given array members are not
+   * validated, since the caller walks into them anyway and continues the validation via items().
+   */
+  void validateObject(const Json::Value& value,
+                      std::initializer_list<const char*> walkedArrays = {}) const {
+    if (table) {
+      validateObjectMembers(value, walkedArrays);
+    }
+  }
+
+  /*!
+   * Returns the position of the items of the given array member of this object.
+   */
+  SSchemaPosition items(const char* arrayMember) const {
+    return table ? findItems(arrayMember) : SSchemaPosition{};
+  }
+
+ private:
+  void validateValue(const Json::Value& value) const;
+  void validateObjectMembers(const Json::Value& value,
+                             std::initializer_list<const char*> walkedArrays) const;
+  SSchemaPosition findItems(const char* arrayMember) const;
+};
+
+}  // namespace mpeghuitranslator
@@ -0,0 +1,181 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+#pragma once
+
+// Internal headers
+#include "mpeghuitranslator/translator.h"
+
+// System headers
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace mpeghuitranslator {
+
+/*!
+ * Processing stages of a translator measured by the statistics, see #STranslatorStatistics.
+ */
+enum EStage {
+  STAGE_XML_PARSE,
+  STAGE_MODEL_BUILD,
+  STAGE_JSON_COMPOSE,
+  STAGE_SERIALIZATION,
+  STAGE_CHANGE_PARSE,
+  STAGE_ACTION_EVENT_COMPOSE,
+  STAGE_MUTEX_WAIT,
+  NUM_STAGES
+};
+
+struct SStageCounters {
+  std::atomic<std::uint64_t> numCalls{0};
+  std::atomic<std::uint64_t> totalNanoseconds{0};
+  std::atomic<std::uint64_t> maxNanoseconds{0};
+};
+
+/*!
+ * Lock-free counters of a translator. All updates use relaxed atomics, since the counters are only
+ * read for monitoring and do not synchronize any other data.
+ */
+struct STranslatorCounters {
+  SStageCounters stages[NUM_STAGES];
+  std::atomic<std::uint64_t> bytesIn{0};
+  std::atomic<std::uint64_t> bytesOut{0};
+  std::atomic<std::uint64_t> numEvents{0};
+
+  void add(EStage stage, std::uint64_t nanoseconds) noexcept {
+    auto& counters = stages[stage];
+    counters.numCalls.fetch_add(1, std::memory_order_relaxed);
+    counters.totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    auto maxValue = counters.maxNanoseconds.load(std::memory_order_relaxed);
+    while (nanoseconds > maxValue && !counters.maxNanoseconds.compare_exchange_weak(
+                                         maxValue, nanoseconds, std::memory_order_relaxed)) {
+    }
+  }
+
+  void addBytesIn(std::size_t numBytes) noexcept {
+    bytesIn.fetch_add(numBytes, std::memory_order_relaxed);
+  }
+
+  void addBytesOut(std::size_t numBytes) noexcept {
+    bytesOut.fetch_add(numBytes, std::memory_order_relaxed);
+  }
+
+  void addEvents(std::size_t num) noexcept { numEvents.fetch_add(num, std::memory_order_relaxed); }
+
+  STranslatorStatistics load() const noexcept;
+
+  void reset() noexcept;
+};
+
+/*!
+ * Measures the time from construction to destruction as one call of the given stage. The counters
+ * may be NULL to not measure anything.
+ */
+class CStageTimer {
+ public:
+  CStageTimer(STranslatorCounters* counters, EStage stage) noexcept
+      : m_counters(counters),
+        m_stage(stage),
+        m_startTime(counters ? std::chrono::steady_clock::now()
+                             : std::chrono::steady_clock::time_point{}) {}
+  CStageTimer(const CStageTimer&) = delete;
+
+  ~CStageTimer() noexcept {
+    if (m_counters) {
+      auto duration = std::chrono::steady_clock::now() - m_startTime;
+      m_counters->add(m_stage, static_cast<std::uint64_t>(
+                                   std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+                                       .count()));
+    }
+  }
+
+  CStageTimer& operator=(const CStageTimer&) = delete;
+
+ private:
+  STranslatorCounters* m_counters;
+  EStage m_stage;
+  std::chrono::steady_clock::time_point m_startTime;
+};
+
+}  // namespace mpeghuitranslator
@@ -0,0 +1,190 @@
+/*-----------------------------------------------------------------------------
+Software License for The Fraunhofer FDK MPEG-H Software
+
+Copyright (c) 2019 - 2024 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. and Contributors
+All rights reserved.
+
+1. INTRODUCTION
+
+The "Fraunhofer FDK MPEG-H Software" is software that implements the ISO/MPEG
+MPEG-H 3D Audio standard for digital audio or related system features. Patent
+licenses for necessary patent claims for the Fraunhofer FDK MPEG-H Software
+(including those of Fraunhofer), for the use in commercial products and
+services, may be obtained from the respective patent owners individually and/or
+from Via LA (www.via-la.com).
+
+Fraunhofer supports the development of MPEG-H products and services by offering
+additional software, documentation, and technical advice. In addition, it
+operates the MPEG-H Trademark Program to ease interoperability testing of end-
+products. Please visit www.mpegh.com for more information.
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted without payment of copyright license fees provided that you
+satisfy the following conditions:
+
+* You must retain the complete text of this software license in redistributions
+of the Fraunhofer FDK MPEG-H Software or your modifications thereto in source
+code form.
+
+* You must retain the complete text of this software license in the
+documentation and/or other materials provided with redistributions of
+the Fraunhofer FDK MPEG-H Software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of
+the Fraunhofer FDK MPEG-H Software and your modifications thereto to recipients
+of copies in binary form.
+
+* The name of Fraunhofer may not be used to endorse or promote products derived
+from the Fraunhofer FDK MPEG-H Software without prior written permission.
+
+* You may not charge copyright license fees for anyone to use, copy or
+distribute the Fraunhofer FDK MPEG-H Software or your modifications thereto.
+
+* Your modified versions of the Fraunhofer FDK MPEG-H Software must carry
+prominent notices stating that you changed the software and the date of any
+change. For modified versions of the Fraunhofer FDK MPEG-H Software, the term
+"Fraunhofer FDK MPEG-H Software" must be replaced by the term "Third-Party
+Modified Version of the Fraunhofer FDK MPEG-H Software".
+
+3. No PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without
+limitation the patents of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE.
+Fraunhofer provides no warranty of patent non-infringement with respect to this
+software. You may use this Fraunhofer FDK MPEG-H Software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+4. DISCLAIMER
+
+This Fraunhofer FDK MPEG-H Software is provided by Fraunhofer on behalf of the
+copyright holders and contributors "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED
+WARRANTIES, including but not limited to the implied warranties of
+merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE
+COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE for any direct, indirect,
+incidental, special, exemplary, or consequential damages, including but not
+limited to procurement of substitute goods or services; loss of use, data, or
+profits, or business interruption, however caused and on any theory of
+liability, whether in contract, strict liability, or tort (including
+negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Audio and Media Technologies - MPEG-H FDK
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+www.iis.fraunhofer.de/amm
+amm-info@iis.fraunhofer.de
+-----------------------------------------------------------------------------*/
+
+// Internal headers
+#include "mpeghuitranslator/trace.h"
+
+// System headers
+#include <chrono>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace mpeghuitranslator {
+
+static const char* const TRACE_HEADER = "MPEGHUI-TRACE 2";
+// Header of the traces written before the display language was recorded
+static const char* const TRACE_HEADER_V1 = "MPEGHUI-TRACE 1";
+
+static const char* toString(ETraceInput input) {
+  switch (input) {
+    case ETraceInput::kAudioSceneXml:
+      return "xml";
+    case ETraceInput::kSceneChangesJson:
+      return "json";
+    case ETraceInput::kDisplayLanguage:
+      return "lang";
+  }
+  return "";
+}
+
+struct STraceRecorderPimpl {
+  explicit STraceRecorderPimpl(std::ostream& out)
+      : output(out), startTime(std::chrono::steady_clock::now()) {}
+
+  std::mutex lock;
+  std::ostream& output;
+  const std::chrono::steady_clock::time_point startTime;
+};
+
+CTraceRecorder::CTraceRecorder(std::ostream& output) : m_pimpl(new STraceRecorderPimpl(output)) {
+  m_pimpl->output << TRACE_HEADER << '\n';
+}
+
+CTraceRecorder::~CTraceRecorder() noexcept = default;
+
+void CTraceRecorder::record(ETraceInput input, const std::string& data) {
+  const auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - m_pimpl->startTime)
+                             .count();
+
+  std::lock_guard<std::mutex> guard{m_pimpl->lock};
+  m_pimpl->output << timestamp << ' ' << toString(input) << ' ' << data.size() << '\n';
+  m_pimpl->output.write(data.data(), static_cast<std::streamsize>(data.size()));
+  m_pimpl->output << '\n';
+  m_pimpl->output.flush();
+}
+
+struct STraceReaderPimpl {
+  explicit STraceReaderPimpl(std::istream& in) : input(in) {}
+
+  std::istream& input;
+};
+
+CTraceReader::CTraceReader(std::istream& input) : m_pimpl(new STraceReaderPimpl(input)) {
+  std::string header;
+  if (!std::getline(input, header) || (header != TRACE_HEADER && header != TRACE_HEADER_V1)) {
+    throw std::runtime_error{"Input is no MPEG-H UI translator trace"};
+  }
+}
+
+CTraceReader::~CTraceReader() noexcept = default;
+
+bool CTraceReader::next(STraceRecord& record) {
+  auto& input = m_pimpl->input;
+
+  std::string line;
+  if (!std::getline(input, line)) {
+    return false;
+  }
+
+  std::istringstream fields{line};
+  std::string kind;
+  std::size_t size = 0;
+  if (!(fields >> record.timestamp >> kind >> size)) {
+    throw std::runtime_error{"Malformed trace record: " + line};
+  }
+  if (kind == "xml") {
+    record.input = ETraceInput::kAudioSceneXml;
+  } else if (kind == "json") {
+    record.input = ETraceInput::kSceneChangesJson;
+  } else if (kind == "lang") {
+    record.input = ETraceInput::kDisplayLanguage;
+  } else {
+    throw std::runtime_error{"Malformed trace record: " + line};
+  }
+
+  record.data.resize(size);
+  if (size > 0) {
+    input.read(&record.data[0], static_cast<std::streamsize>(size));
+  }
+  if (static_cast<std::size_t>(input.gcount()) != size && size > 0) {
+    throw std::runtime_error{"Trace ended within a record"};
+  }
+  // skip the line break terminating the data
+  input.ignore(1);
+  return true;
+}
+
+}  // namespace mpeghuitranslator
@@ -90,6 +90,9 @@ amm-info@iis.fraunhofer.de
 
 // System headers
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
 
 static const std::string NO_UUID = "00000000-0000-0000-0000-000000000000";
@@ -107,8 +110,9 @@ static const T& assertForId(const std::vector<T>& list, int id) {
 }
 
 template <typename T>
-static const T* findActive(const std::vector<T>& list) {
-  auto it = std::find_if(list.begin(), list.end(), [](const T& entry) { return entry.isActive; });
+static const T* findActive(const std::vector<T>& list, const SAudioSceneValues& values) {
+  auto it = std::find_if(list.begin(), list.end(),
+                         [&values](const T& entry) { return isActive(values, entry); });
   if (it != list.end()) {
     return &*it;
   }
@@ -116,12 +120,13 @@ static const T* findActive(const std::vector<T>& list) {
 }
 
 template <typename T, typename V>
-static bool isChanged(const SValueChange<T>& change, const std::unique_ptr<V>& value) {
+static bool isChanged(const SValueChange<T>& change, const std::unique_ptr<V>& value,
+                      const SAudioSceneValues& values) {
   if (change.isChanged && !value) {
     // no previous value to compare to
     return true;
   }
-  if (value && change.isUpdated(value->currentValue)) {
+  if (value && change.isUpdated(getCurrentValue(values, *value))) {
     // value is different than previous value
     return true;
   }
@@ -145,22 +150,165 @@ static void setNodeProperty(xmlNodePtr node, const char* name, T value) {
              reinterpret_cast<const xmlChar*>(tmp.data()));
 }
 
-template <typename Func = void (*)(xmlNodePtr)>
-static std::string composeActionEvent(int actionType, const std::string& uuid,
-                                      Func&& setProperties) {
+/*!
+ * Appends ActionEvents to the given list. The events already contained in the list are overwritten
+ * instead of being replaced, so that their strings keep their capacity.
+ */
+class CActionEventList {
+ public:
+  explicit CActionEventList(std::vector<SActionEvent>& events) : m_events(events) {}
+
+  SActionEvent& add(int actionType, const SUuid& uuid) {
+    if (m_numEvents == m_events.size()) {
+      m_events.emplace_back();
+    }
+    auto& event = m_events[m_numEvents++];
+    event.actionType = actionType;
+    event.uuid = uuid;
+    event.paramText.isChanged = false;
+    event.paramInt.isChanged = false;
+    event.paramFloat.isChanged = false;
+    event.selectedItemId.isChanged = false;
+    event.paramBool.isChanged = false;
+    return event;
+  }
+
+  template <typename T>
+  void add(int actionType, const SUuid& uuid, int paramInt, SValueChange<T> SActionEvent::*param,
+           const T& value) {
+    auto& event = add(actionType, uuid);
+    event.paramInt.set(paramInt);
+    (event.*param).set(value);
+  }
+
+  /*!
+   * Removes the remaining events of previous uses of the list.
+   */
+  void finish() { m_events.resize(m_numEvents); }
+
+ private:
+  std::vector<SActionEvent>& m_events;
+  std::size_t m_numEvents = 0;
+};
+
+/*!
+ * Sets the attributes of an ActionEvent element created with libxml2.
+ */
+class CXmlAttributeWriter {
+ public:
+  explicit CXmlAttributeWriter(xmlNodePtr node) : m_node(node) {}
+
+  template <typename T>
+  void set(const char* name, const T& value) {
+    setNodeProperty(m_node, name, value);
+  }
+
+ private:
+  xmlNodePtr m_node;
+};
+
+/*!
+ * Appends the attributes of an ActionEvent element to an XML string in the same format as
+ * libxml2 serializes them. Only values which do not need to be escaped can be written.
+ */
+class CStringAttributeWriter {
+ public:
+  explicit CStringAttributeWriter(std::string& out) : m_out(out) {}
+
+  void set(const char* name, const std::string& value) { append(name, value.data(), value.size()); }
+
+  void set(const char* name, bool value) {
+    const auto* text = value ? "true" : "false";
+    append(name, text, std::strlen(text));
+  }
+
+  // Same formats as std::to_string(), without allocating the formatted string
+  void set(const char* name, int value) { format(name, "%d", value); }
+
+  void set(const char* name, double value) { format(name, "%f", value); }
+
+ private:
+  template <typename T>
+  void format(const char* name, const char* format, T value) {
+    char buffer[std::numeric_limits<double>::max_exponent10 + 32];
+    const int numChars = std::snprintf(buffer, sizeof(buffer), format, value);
+    append(name, buffer, static_cast<std::size_t>(std::max(numChars, 0)));
+  }
+
+  void append(const char* name, const char* value, std::size_t size) {
+    m_out += ' ';
+    m_out += name;
+    m_out += "=\"";
+    m_out.append(value, size);
+    m_out += '"';
+  }
+
+  std::string& m_out;
+};
+
+/*!
+ * Returns whether libxml2 serializes the given attribute value unchanged, i.e. it only consists of
+ * printable ASCII characters which do not need to be escaped.
+ */
+static bool isPlainAttributeValue(const std::string& value) {
+  return std::all_of(value.begin(), value.end(), [](char c) {
+    return c >= 0x20 && c <= 0x7E && c != '<' && c != '>' && c != '&' && c != '"';
+  });
+}
+
+template <typename W>
+static void writeActionEventAttributes(const SActionEvent& event, W& writer) {
+  writer.set("uuid", event.uuid);
+  writer.set("actionType", event.actionType);
+  writer.set("version", std::string{"9.0"});
+  if (event.paramText.isChanged) {
+    writer.set("paramText", event.paramText.newValue);
+  }
+  if (event.paramInt.isChanged) {
+    writer.set("paramInt", event.paramInt.newValue);
+  }
+  if (event.paramFloat.isChanged) {
+    writer.set("paramFloat", event.paramFloat.newValue);
+  } else if (event.selectedItemId.isChanged) {
+    writer.set("paramFloat", event.selectedItemId.newValue);
+  }
+  if (event.paramBool.isChanged) {
+    writer.set("paramBool", event.paramBool.newValue);
+  }
+}
+
+std::string composeActionEvent(const SActionEvent& event) {
+  std::string result;
+  composeActionEvent(event, result);
+  return result;
+}
+
+void composeActionEvent(const SActionEvent& event, std::string& outXml) {
+  // The ActionEvent only consists of a single element, so it is written directly into the output
+  // without a libxml2 document, unless its strings need to be escaped
+  if (isPlainAttributeValue(event.uuid) &&
+      (!event.paramText.isChanged || isPlainAttributeValue(event.paramText.newValue))) {
+    // enough for all attributes unless the floating-point value is very large
+    const auto expectedSize = 192 + event.uuid.size() + event.paramText.newValue.size();
+    if (outXml.capacity() < expectedSize) {
+      outXml.reserve(expectedSize);
+    }
+    outXml.assign("<?xml version=\"1.0\"?>\n<ActionEvent");
+    CStringAttributeWriter writer{outXml};
+    writeActionEventAttributes(event, writer);
+    outXml += "/>\n";
+    return;
+  }
+
   CXmlDocument doc{xmlNewDoc(reinterpret_cast<const xmlChar*>("1.0"))};
-  auto root = doc.createRoot("ActionEvent");
-  setNodeProperty(root, "uuid", uuid);
-  setNodeProperty(root, "actionType", actionType);
-  setNodeProperty(root, "version", std::string{"9.0"});
-  setProperties(root);
+  CXmlAttributeWriter writer{doc.createRoot("ActionEvent")};
+  writeActionEventAttributes(event, writer);
 
   xmlChar* buffer = nullptr;
   int numChars = 0;
   xmlDocDumpMemory(doc.getDocument(), &buffer, &numChars);
-  std::string result(reinterpret_cast<const char*>(buffer));
+  outXml.assign(reinterpret_cast<const char*>(buffer));
   xmlFree(buffer);
-  return result;
 }
 
 // For AudioScene XML version 9.0, we only have the objects for the current preset and on
@@ -168,50 +316,48 @@ static std::string composeActionEvent(int actionType, const std::string& uuid,
 // level, but entries for all presets on Preset level.
 
 static const std::vector<SAudioElement>& selectAudioElements(
-    const SPreset& preset, const SAudioSceneConfig& asi) noexcept {
-  if (preset.isActive && preset.audioElements.empty()) {
+    const SPreset& preset, const SAudioSceneConfig& asi, const SAudioSceneValues& values) noexcept {
+  if (isActive(values, preset) && preset.audioElements.empty()) {
     return asi.audioElements;
   }
   return preset.audioElements;
 }
 
 static const std::vector<SAudioElementSwitch>& selectSwitchGroups(
-    const SPreset& preset, const SAudioSceneConfig& asi) noexcept {
-  if (preset.isActive && preset.switchGroups.empty()) {
+    const SPreset& preset, const SAudioSceneConfig& asi, const SAudioSceneValues& values) noexcept {
+  if (isActive(values, preset) && preset.switchGroups.empty()) {
     return asi.switchGroups;
   }
   return preset.switchGroups;
 }
 
-std::vector<std::string> composeActionEvents(const SAudioSceneChanges& sceneChanges,
-                                             const SAudioSceneConfig* baseAsi,
-                                             const std::string* baseDisplayLanguageCode) {
-  std::vector<std::string> result;
+static void appendActionEvents(const SAudioSceneChanges& sceneChanges, const SAudioScene* baseScene,
+                               const std::string* baseDisplayLanguageCode,
+                               CActionEventList& result) {
+  const auto& uuid = sceneChanges.uuid;
 
   if (sceneChanges.displayLanguage.isChanged &&
       (!baseDisplayLanguageCode ||
        sceneChanges.displayLanguage.isUpdated(*baseDisplayLanguageCode))) {
-    result.push_back(
-        composeActionEvent(71 /* INTERFACE_LANGUAGE_SELECTED */, NO_UUID, [&](xmlNodePtr node) {
-          setNodeProperty(node, "paramText", sceneChanges.displayLanguage.newValue);
-          setNodeProperty(node, "paramInt", 0 /* priority */);
-        }));
+    auto& event = result.add(ACTION_INTERFACE_LANGUAGE_SELECTED, NO_UUID);
+    event.paramText.set(sceneChanges.displayLanguage.newValue);
+    event.paramInt.set(0 /* priority */);
   }
 
-  if (!baseAsi) {
+  if (!baseScene) {
     // cannot generate any other ActionEvent without a valid scene UUID
-    return result;
+    return;
   }
+  const auto* baseAsi = baseScene->config.get();
+  const auto& baseValues = baseScene->values;
 
   for (const auto& presetChanges : sceneChanges.presets) {
     const auto& basePreset = assertForId(baseAsi->presets, presetChanges.id);
 
     if (presetChanges.isActive.newValue) {
-      const auto* previousActivePreset = baseAsi ? findActive(baseAsi->presets) : nullptr;
+      const auto* previousActivePreset = findActive(baseAsi->presets, baseValues);
       if (!previousActivePreset || previousActivePreset->id != presetChanges.id) {
-        result.push_back(composeActionEvent(
-            30 /* PRESET_SELECTED */, sceneChanges.uuid,
-            [&](xmlNodePtr node) { setNodeProperty(node, "paramInt", presetChanges.id); }));
+        result.add(ACTION_PRESET_SELECTED, uuid).paramInt.set(presetChanges.id);
       }
     }
 
@@ -221,39 +367,26 @@ std::vector<std::string> composeActionEvents(const SAudioSceneChanges& sceneChan
         continue;
       }
       const auto& baseElement =
-          assertForId(selectAudioElements(basePreset, *baseAsi), elementChanges.id);
-
-      if (isChanged(elementChanges.prominence, baseElement.prominence)) {
-        result.push_back(composeActionEvent(41 /* AUDIO_ELEMENT_PROMINENCE_LEVEL_CHANGED */,
-                                            sceneChanges.uuid, [&](xmlNodePtr node) {
-                                              setNodeProperty(node, "paramInt", elementChanges.id);
-                                              setNodeProperty(node, "paramFloat",
-                                                              elementChanges.prominence.newValue);
-                                            }));
+          assertForId(selectAudioElements(basePreset, *baseAsi, baseValues), elementChanges.id);
+
+      if (isChanged(elementChanges.prominence, baseElement.prominence, baseValues)) {
+        result.add(ACTION_AUDIO_ELEMENT_PROMINENCE_LEVEL_CHANGED, uuid, elementChanges.id,
+                   &SActionEvent::paramFloat, elementChanges.prominence.newValue);
       }
 
-      if (isChanged(elementChanges.muting, baseElement.muting)) {
-        result.push_back(composeActionEvent(
-            40 /* AUDIO_ELEMENT_MUTING_CHANGED */, sceneChanges.uuid, [&](xmlNodePtr node) {
-              setNodeProperty(node, "paramInt", elementChanges.id);
-              setNodeProperty(node, "paramBool", elementChanges.muting.newValue);
-            }));
+      if (isChanged(elementChanges.muting, baseElement.muting, baseValues)) {
+        result.add(ACTION_AUDIO_ELEMENT_MUTING_CHANGED, uuid, elementChanges.id,
+                   &SActionEvent::paramBool, elementChanges.muting.newValue);
       }
 
-      if (isChanged(elementChanges.azimuth, baseElement.azimuth)) {
-        result.push_back(composeActionEvent(
-            42 /* ELEMENT_AZIMUTH_CHANGED */, sceneChanges.uuid, [&](xmlNodePtr node) {
-              setNodeProperty(node, "paramInt", elementChanges.id);
-              setNodeProperty(node, "paramFloat", elementChanges.azimuth.newValue);
-            }));
+      if (isChanged(elementChanges.azimuth, baseElement.azimuth, baseValues)) {
+        result.add(ACTION_AUDIO_ELEMENT_AZIMUTH_CHANGED, uuid, elementChanges.id,
+                   &SActionEvent::paramFloat, elementChanges.azimuth.newValue);
       }
 
-      if (isChanged(elementChanges.elevation, baseElement.elevation)) {
-        result.push_back(composeActionEvent(
-            43 /* AUDIO_ELEMENT_ELEVATION_CHANGED */, sceneChanges.uuid, [&](xmlNodePtr node) {
-              setNodeProperty(node, "paramInt", elementChanges.id);
-              setNodeProperty(node, "paramFloat", elementChanges.elevation.newValue);
-            }));
+      if (isChanged(elementChanges.elevation, baseElement.elevation, baseValues)) {
+        result.add(ACTION_AUDIO_ELEMENT_ELEVATION_CHANGED, uuid, elementChanges.id,
+                   &SActionEvent::paramFloat, elementChanges.elevation.newValue);
       }
     }
 
@@ -262,25 +395,19 @@ std::vector<std::string> composeActionEvents(const SAudioSceneChanges& sceneChan
         continue;
       }
       const auto& baseGroup =
-          assertForId(selectSwitchGroups(basePreset, *baseAsi), groupChanges.id);
+          assertForId(selectSwitchGroups(basePreset, *baseAsi, baseValues), groupChanges.id);
 
       if (groupChanges.activeObject.isChanged) {
-        const auto* activeItem = findActive(baseGroup.audioElements);
+        const auto* activeItem = findActive(baseGroup.audioElements, baseValues);
         if (!activeItem || groupChanges.activeObject.isUpdated(activeItem->id)) {
-          result.push_back(composeActionEvent(
-              60 /* AUDIO_ELEMENT_SWITCH_SELECTED */, sceneChanges.uuid, [&](xmlNodePtr node) {
-                setNodeProperty(node, "paramInt", groupChanges.id);
-                setNodeProperty(node, "paramFloat", groupChanges.activeObject.newValue);
-              }));
+          result.add(ACTION_AUDIO_ELEMENT_SWITCH_SELECTED, uuid, groupChanges.id,
+                     &SActionEvent::selectedItemId, groupChanges.activeObject.newValue);
         }
       }
 
-      if (isChanged(groupChanges.muting, baseGroup.muting)) {
-        result.push_back(composeActionEvent(
-            61 /* AUDIO_ELEMENT_SWITCH_MUTING_CHANGED */, sceneChanges.uuid, [&](xmlNodePtr node) {
-              setNodeProperty(node, "paramInt", groupChanges.id);
-              setNodeProperty(node, "paramBool", groupChanges.muting.newValue);
-            }));
+      if (isChanged(groupChanges.muting, baseGroup.muting, baseValues)) {
+        result.add(ACTION_AUDIO_ELEMENT_SWITCH_MUTING_CHANGED, uuid, groupChanges.id,
+                   &SActionEvent::paramBool, groupChanges.muting.newValue);
       }
 
       for (const auto& elementChanges : groupChanges.audioElements) {
@@ -292,36 +419,51 @@ std::vector<std::string> composeActionEvents(const SAudioSceneChanges& sceneChan
         // Currently there is no way of signaling muting for audio elements in switch groups,
         // therefore muting changes are not listed here.
 
-        if (isChanged(elementChanges.prominence, baseGroup.prominence)) {
-          result.push_back(composeActionEvent(
-              62 /* AUDIO_ELEMENT_SWITCH_PROMINENCE_LEVEL_CHANGED */, sceneChanges.uuid,
-              [&](xmlNodePtr node) {
-                setNodeProperty(node, "paramInt", groupChanges.id);
-                setNodeProperty(node, "paramFloat", elementChanges.prominence.newValue);
-              }));
+        if (isChanged(elementChanges.prominence, baseGroup.prominence, baseValues)) {
+          result.add(ACTION_AUDIO_ELEMENT_SWITCH_PROMINENCE_LEVEL_CHANGED, uuid, groupChanges.id,
+                     &SActionEvent::paramFloat, elementChanges.prominence.newValue);
         }
 
-        if (isChanged(elementChanges.azimuth, baseGroup.azimuth)) {
-          result.push_back(composeActionEvent(63 /* AUDIO_ELEMENT_SWITCH_AZIMUTH_CHANGED */,
-                                              sceneChanges.uuid, [&](xmlNodePtr node) {
-                                                setNodeProperty(node, "paramInt", groupChanges.id);
-                                                setNodeProperty(node, "paramFloat",
-                                                                elementChanges.azimuth.newValue);
-                                              }));
+        if (isChanged(elementChanges.azimuth, baseGroup.azimuth, baseValues)) {
+          result.add(ACTION_AUDIO_ELEMENT_SWITCH_AZIMUTH_CHANGED, uuid, groupChanges.id,
+                     &SActionEvent::paramFloat, elementChanges.azimuth.newValue);
         }
 
-        if (isChanged(elementChanges.elevation, baseGroup.elevation)) {
-          result.push_back(composeActionEvent(64 /* AUDIO_ELEMENT_SWITCH_ELEVATION_CHANGED */,
-                                              sceneChanges.uuid, [&](xmlNodePtr node) {
-                                                setNodeProperty(node, "paramInt", groupChanges.id);
-                                                setNodeProperty(node, "paramFloat",
-                                                                elementChanges.elevation.newValue);
-                                              }));
+        if (isChanged(elementChanges.elevation, baseGroup.elevation, baseValues)) {
+          result.add(ACTION_AUDIO_ELEMENT_SWITCH_ELEVATION_CHANGED, uuid, groupChanges.id,
+                     &SActionEvent::paramFloat, elementChanges.elevation.newValue);
         }
       }
     }
   }
+}
+
+void collectActionEvents(const SAudioSceneChanges& sceneChanges, const SAudioScene* baseScene,
+                         const std::string* baseDisplayLanguageCode,
+                         std::vector<SActionEvent>& outEvents) {
+  CActionEventList events{outEvents};
+  appendActionEvents(sceneChanges, baseScene, baseDisplayLanguageCode, events);
+  events.finish();
+}
+
+std::vector<SActionEvent> collectActionEvents(const SAudioSceneChanges& sceneChanges,
+                                              const SAudioScene* baseScene,
+                                              const std::string* baseDisplayLanguageCode) {
+  std::vector<SActionEvent> result;
+  collectActionEvents(sceneChanges, baseScene, baseDisplayLanguageCode, result);
+  return result;
+}
+
+std::vector<std::string> composeActionEvents(const SAudioSceneChanges& sceneChanges,
+                                             const SAudioScene* baseScene,
+                                             const std::string* baseDisplayLanguageCode) {
+  auto events = collectActionEvents(sceneChanges, baseScene, baseDisplayLanguageCode);
 
+  std::vector<std::string> result;
+  result.reserve(events.size());
+  for (const auto& event : events) {
+    result.push_back(composeActionEvent(event));
+  }
   return result;
 }
 
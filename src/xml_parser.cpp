@@ -88,6 +88,7 @@ amm-info@iis.fraunhofer.de
 
 // System headers
 #include <algorithm>
+#include <cstring>
 #include <limits>
 #include <stdexcept>
 #include <type_traits>
@@ -102,10 +103,10 @@ namespace mpeghuitranslator {
  *
  * Returns NULL if no more matching children in the given parent exist.
  */
-static xmlNodePtr findNextChild(xmlNodePtr parent, const std::string& name,
+static xmlNodePtr findNextChild(xmlNodePtr parent, const char* name,
                                 xmlNodePtr prevChild = nullptr) {
   for (auto child = prevChild ? prevChild->next : parent->children; child; child = child->next) {
-    if (reinterpret_cast<const char*>(child->name) == name) {
+    if (xmlStrEqual(child->name, reinterpret_cast<const xmlChar*>(name))) {
       return child;
     }
   }
@@ -115,37 +116,99 @@ static xmlNodePtr findNextChild(xmlNodePtr parent, const std::string& name,
 /*!
  * Returns the first direct child of the given parent with the given node name.
  */
-static xmlNodePtr findFirstChild(xmlNodePtr node, const std::string& name) {
+static xmlNodePtr findFirstChild(xmlNodePtr node, const char* name) {
   return findNextChild(node, name);
 }
 
-static bool parseNodeProperty(xmlNodePtr node, std::string& outValue, const std::string& name) {
-  if (auto val = xmlGetProp(node, reinterpret_cast<const xmlChar*>(name.data()))) {
-    outValue = std::string(reinterpret_cast<const char*>(val));
-    xmlFree(val);
+/*!
+ * Text of a node property or of a text-only node, which refers to the text node of the document in
+ * place if possible. Only text with several parts (e.g. entity references) is copied by libxml2.
+ */
+class CNodeText {
+ public:
+  CNodeText() = default;
+  CNodeText(const CNodeText&) = delete;
+  ~CNodeText() noexcept {
+    if (m_copy) {
+      xmlFree(m_copy);
+    }
+  }
+
+  CNodeText& operator=(const CNodeText&) = delete;
+
+  /*!
+   * Reads the text of the given property of the given node, returns false if there is none.
+   */
+  bool readProperty(xmlNodePtr node, const char* name) {
+    auto property = xmlHasProp(node, reinterpret_cast<const xmlChar*>(name));
+    if (!property) {
+      return false;
+    }
+    if (property->type == XML_ATTRIBUTE_NODE && !property->children) {
+      m_value = "";
+    } else if (property->type != XML_ATTRIBUTE_NODE || !readTextInPlace(property->children)) {
+      m_copy = xmlGetProp(node, reinterpret_cast<const xmlChar*>(name));
+      m_value = reinterpret_cast<const char*>(m_copy);
+    }
+    return m_value != nullptr;
+  }
+
+  /*!
+   * Reads the text content of the given node, returns false if it has none.
+   */
+  bool readContent(xmlNodePtr node) {
+    if (!node->children) {
+      m_value = "";
+    } else if (!readTextInPlace(node->children)) {
+      m_copy = xmlNodeGetContent(node);
+      m_value = reinterpret_cast<const char*>(m_copy);
+    }
+    return m_value != nullptr;
+  }
+
+  const char* get() const noexcept { return m_value; }
+
+ private:
+  bool readTextInPlace(xmlNodePtr children) noexcept {
+    if (children->next || children->type != XML_TEXT_NODE || !children->content) {
+      return false;
+    }
+    m_value = reinterpret_cast<const char*>(children->content);
+    return true;
+  }
+
+  xmlChar* m_copy = nullptr;
+  const char* m_value = nullptr;
+};
+
+static bool parseNodeProperty(xmlNodePtr node, std::string& outValue, const char* name) {
+  CNodeText val{};
+  if (val.readProperty(node, name)) {
+    outValue.assign(val.get());
     return true;
   }
   return false;
 }
 
-static bool parseNodeProperty(xmlNodePtr node, bool& outValue, const std::string& name) {
-  if (auto val = xmlGetProp(node, reinterpret_cast<const xmlChar*>(name.data()))) {
-    outValue = std::string{"true"} == reinterpret_cast<const char*>(val);
-    xmlFree(val);
+static bool parseNodeProperty(xmlNodePtr node, bool& outValue, const char* name) {
+  CNodeText val{};
+  if (val.readProperty(node, name)) {
+    outValue = std::strcmp(val.get(), "true") == 0;
     return true;
   }
   return false;
 }
 
-static bool parseNodeProperty(xmlNodePtr node, float& outValue, const std::string& name) {
-  if (auto val = xmlGetProp(node, reinterpret_cast<const xmlChar*>(name.data()))) {
-    std::string tmpValue(reinterpret_cast<const char*>(val));
-    xmlFree(val);
+static bool parseNodeProperty(xmlNodePtr node, float& outValue, const char* name) {
+  CNodeText val{};
+  if (val.readProperty(node, name)) {
+    // short values fit into the small string buffer, so this does not allocate
+    std::string tmpValue(val.get());
 
     std::size_t numDigits = std::string::npos;
     auto tmp = std::stof(tmpValue, &numDigits);
     if (numDigits != tmpValue.size()) {
-      throw std::invalid_argument{"Property value of '" + name +
+      throw std::invalid_argument{std::string{"Property value of '"} + name +
                                   "' is not floating-point: " + tmpValue};
     }
     outValue = tmp;
@@ -154,15 +217,16 @@ static bool parseNodeProperty(xmlNodePtr node, float& outValue, const std::strin
   return false;
 }
 
-static bool parseNodeProperty(xmlNodePtr node, std::intmax_t& outValue, const std::string& name) {
-  if (auto val = xmlGetProp(node, reinterpret_cast<const xmlChar*>(name.data()))) {
-    std::string tmpValue(reinterpret_cast<const char*>(val));
-    xmlFree(val);
+static bool parseNodeProperty(xmlNodePtr node, std::intmax_t& outValue, const char* name) {
+  CNodeText val{};
+  if (val.readProperty(node, name)) {
+    std::string tmpValue(val.get());
 
     std::size_t numDigits = std::string::npos;
     auto tmp = std::stoll(tmpValue, &numDigits);
     if (numDigits != tmpValue.size()) {
-      throw std::invalid_argument{"Property value of '" + name + "' is not integral: " + tmpValue};
+      throw std::invalid_argument{std::string{"Property value of '"} + name +
+                                  "' is not integral: " + tmpValue};
     }
     outValue = tmp;
     return true;
@@ -172,13 +236,13 @@ static bool parseNodeProperty(xmlNodePtr node, std::intmax_t& outValue, const st
 
 template <typename T>
 static typename std::enable_if<std::is_integral<T>::value, bool>::type parseNodeProperty(
-    xmlNodePtr node, T& outValue, const std::string& name) {
+    xmlNodePtr node, T& outValue, const char* name) {
   std::intmax_t tmpValue{};
   if (!parseNodeProperty(node, tmpValue, name)) {
     return false;
   }
   if (tmpValue < std::numeric_limits<T>::min() || tmpValue > std::numeric_limits<T>::max()) {
-    throw std::invalid_argument{"Property value of '" + name +
+    throw std::invalid_argument{std::string{"Property value of '"} + name +
                                 "' is out of range: " + std::to_string(tmpValue)};
   }
   outValue = static_cast<T>(tmpValue);
@@ -186,7 +250,7 @@ static typename std::enable_if<std::is_integral<T>::value, bool>::type parseNode
 }
 
 template <typename T>
-static void parseMandatoryNodeProperty(xmlNodePtr node, T& outValue, const std::string& name) {
+static void parseMandatoryNodeProperty(xmlNodePtr node, T& outValue, const char* name) {
   if (!parseNodeProperty(node, outValue, name)) {
     std::string nodeName(reinterpret_cast<const char*>(node->name));
     throw std::invalid_argument{nodeName + " has no '" + name + "' property"};
@@ -194,7 +258,7 @@ static void parseMandatoryNodeProperty(xmlNodePtr node, T& outValue, const std::
 }
 
 template <typename T>
-static std::unique_ptr<T> parseOptionalChild(xmlNodePtr node, const std::string& name,
+static std::unique_ptr<T> parseOptionalChild(xmlNodePtr node, const char* name,
                                              T (*parseElement)(xmlNodePtr)) {
   if (auto element = findFirstChild(node, name)) {
     return std::unique_ptr<T>{new T(parseElement(element))};
@@ -202,6 +266,27 @@ static std::unique_ptr<T> parseOptionalChild(xmlNodePtr node, const std::string&
   return nullptr;
 }
 
+template <typename T>
+static std::unique_ptr<T> parseOptionalChild(xmlNodePtr node, const char* name,
+                                             T (*parseElement)(xmlNodePtr, SAudioSceneValues&),
+                                             SAudioSceneValues& values) {
+  if (auto element = findFirstChild(node, name)) {
+    return std::unique_ptr<T>{new T(parseElement(element, values))};
+  }
+  return nullptr;
+}
+
+/*!
+ * Parses the given mandatory property as current value and returns its slot in the given values.
+ */
+template <typename T>
+static SValueSlot parseCurrentValue(xmlNodePtr node, const char* name,
+                                    SAudioSceneValues& values) {
+  T value{};
+  parseMandatoryNodeProperty(node, value, name);
+  return addCurrentValue(values, static_cast<float>(value));
+}
+
 static SDrcInfo parseDrcInfo(xmlNodePtr node) {
   SDrcInfo info{};
 
@@ -217,9 +302,9 @@ static SDrcInfo parseDrcInfo(xmlNodePtr node) {
 
 static SLocalizedString parseLocalizedString(xmlNodePtr node) {
   SLocalizedString string{};
-  if (auto content = xmlNodeGetContent(node)) {
-    string.value = std::string(reinterpret_cast<const char*>(content));
-    xmlFree(content);
+  CNodeText content{};
+  if (content.readContent(node)) {
+    string.value.assign(content.get());
   }
   parseMandatoryNodeProperty(node, string.langCode, "langCode");
   return string;
@@ -277,40 +362,40 @@ static void fillPropertyCommon(xmlNodePtr node, SPropertyCommon& property) {
   parseMandatoryNodeProperty(node, property.isActionAllowed, "isActionAllowed");
 }
 
-static SProminenceLevelProperty parseProminenceLevel(xmlNodePtr node) {
+static SProminenceLevelProperty parseProminenceLevel(xmlNodePtr node, SAudioSceneValues& values) {
   SProminenceLevelProperty property{};
   fillPropertyCommon(node, property);
   parseMandatoryNodeProperty(node, property.minValue, "min");
   parseMandatoryNodeProperty(node, property.maxValue, "max");
-  parseMandatoryNodeProperty(node, property.currentValue, "val");
+  property.valueSlot = parseCurrentValue<float>(node, "val", values);
   parseMandatoryNodeProperty(node, property.defaultValue, "def");
   return property;
 }
 
-static SMutingProperty parseMuting(xmlNodePtr node) {
+static SMutingProperty parseMuting(xmlNodePtr node, SAudioSceneValues& values) {
   SMutingProperty property{};
   fillPropertyCommon(node, property);
-  parseMandatoryNodeProperty(node, property.currentValue, "val");
+  property.valueSlot = parseCurrentValue<bool>(node, "val", values);
   parseMandatoryNodeProperty(node, property.defaultValue, "def");
   return property;
 }
 
-static SAzimuthProperty parseAzimuth(xmlNodePtr node) {
+static SAzimuthProperty parseAzimuth(xmlNodePtr node, SAudioSceneValues& values) {
   SAzimuthProperty property{};
   fillPropertyCommon(node, property);
   parseMandatoryNodeProperty(node, property.minValue, "min");
   parseMandatoryNodeProperty(node, property.maxValue, "max");
-  parseMandatoryNodeProperty(node, property.currentValue, "val");
+  property.valueSlot = parseCurrentValue<float>(node, "val", values);
   parseMandatoryNodeProperty(node, property.defaultValue, "def");
   return property;
 }
 
-static SElevationProperty parseElevation(xmlNodePtr node) {
+static SElevationProperty parseElevation(xmlNodePtr node, SAudioSceneValues& values) {
   SElevationProperty property{};
   fillPropertyCommon(node, property);
   parseMandatoryNodeProperty(node, property.minValue, "min");
   parseMandatoryNodeProperty(node, property.maxValue, "max");
-  parseMandatoryNodeProperty(node, property.currentValue, "val");
+  property.valueSlot = parseCurrentValue<float>(node, "val", values);
   parseMandatoryNodeProperty(node, property.defaultValue, "def");
   return property;
 }
@@ -329,13 +414,14 @@ static SCustomAudioElementKind parseCustomAudioElementKind(xmlNodePtr node) {
   return customKind;
 }
 
-static SAudioElement parseAudioElement(xmlNodePtr node) {
+static SAudioElement parseAudioElement(xmlNodePtr node, SAudioSceneValues& values) {
   SAudioElement audioElement{};
 
-  audioElement.prominence = parseOptionalChild(node, "prominenceLevelProp", parseProminenceLevel);
-  audioElement.muting = parseOptionalChild(node, "mutingProp", parseMuting);
-  audioElement.azimuth = parseOptionalChild(node, "azimuthProp", parseAzimuth);
-  audioElement.elevation = parseOptionalChild(node, "elevationProp", parseElevation);
+  audioElement.prominence =
+      parseOptionalChild(node, "prominenceLevelProp", parseProminenceLevel, values);
+  audioElement.muting = parseOptionalChild(node, "mutingProp", parseMuting, values);
+  audioElement.azimuth = parseOptionalChild(node, "azimuthProp", parseAzimuth, values);
+  audioElement.elevation = parseOptionalChild(node, "elevationProp", parseElevation, values);
   audioElement.kind = parseOptionalChild(node, "kind", parseAudioElementKind);
   audioElement.customKind = parseOptionalChild(node, "customKind", parseCustomAudioElementKind);
 
@@ -345,7 +431,8 @@ static SAudioElement parseAudioElement(xmlNodePtr node) {
   return audioElement;
 }
 
-static SAudioElementSwitchItem parseAudioElementSwitchItem(xmlNodePtr node, bool interactive) {
+static SAudioElementSwitchItem parseAudioElementSwitchItem(xmlNodePtr node, bool interactive,
+                                                           SAudioSceneValues& values) {
   SAudioElementSwitchItem item{};
 
   item.kind = parseOptionalChild(node, "kind", parseAudioElementKind);
@@ -355,11 +442,11 @@ static SAudioElementSwitchItem parseAudioElementSwitchItem(xmlNodePtr node, bool
   parseMandatoryNodeProperty(node, item.isAvailable, "isAvailable");
 
   if (interactive) {
-    parseMandatoryNodeProperty(node, item.isActive, "isActive");
+    item.isActiveSlot = parseCurrentValue<bool>(node, "isActive", values);
     parseMandatoryNodeProperty(node, item.isDefault, "isDefault");
     parseNodeProperty(node, item.isSelectable, "isSelectable");
   } else {
-    item.isActive = true;
+    item.isActiveSlot = addCurrentValue(values, 1.0f);
     item.isDefault = true;
     item.isSelectable = true;
   }
@@ -367,26 +454,29 @@ static SAudioElementSwitchItem parseAudioElementSwitchItem(xmlNodePtr node, bool
   return item;
 }
 
-static std::vector<SAudioElementSwitchItem> parseAudioElementSwitchItems(xmlNodePtr node) {
+static std::vector<SAudioElementSwitchItem> parseAudioElementSwitchItems(
+    xmlNodePtr node, SAudioSceneValues& values) {
   std::vector<SAudioElementSwitchItem> result;
   xmlNodePtr preset = nullptr;
   while ((preset = findNextChild(node, "audioElement", preset))) {
-    result.push_back(parseAudioElementSwitchItem(preset, true /* interactive */));
+    result.push_back(parseAudioElementSwitchItem(preset, true /* interactive */, values));
   }
 
   return result;
 }
 
-static SAudioElementSwitch parseAudioElementSwitchGroup(xmlNodePtr node) {
+static SAudioElementSwitch parseAudioElementSwitchGroup(xmlNodePtr node,
+                                                        SAudioSceneValues& values) {
   SAudioElementSwitch switchGroup{};
 
-  switchGroup.prominence = parseOptionalChild(node, "prominenceLevelProp", parseProminenceLevel);
-  switchGroup.muting = parseOptionalChild(node, "mutingProp", parseMuting);
-  switchGroup.azimuth = parseOptionalChild(node, "azimuthProp", parseAzimuth);
-  switchGroup.elevation = parseOptionalChild(node, "elevationProp", parseElevation);
+  switchGroup.prominence =
+      parseOptionalChild(node, "prominenceLevelProp", parseProminenceLevel, values);
+  switchGroup.muting = parseOptionalChild(node, "mutingProp", parseMuting, values);
+  switchGroup.azimuth = parseOptionalChild(node, "azimuthProp", parseAzimuth, values);
+  switchGroup.elevation = parseOptionalChild(node, "elevationProp", parseElevation, values);
 
   if (auto audioElements = findFirstChild(node, "audioElements")) {
-    switchGroup.audioElements = parseAudioElementSwitchItems(audioElements);
+    switchGroup.audioElements = parseAudioElementSwitchItems(audioElements, values);
   } else {
     throw std::invalid_argument{"AudioElementSwitch has no 'audioElements' property"};
   }
@@ -401,12 +491,13 @@ static SAudioElementSwitch parseAudioElementSwitchGroup(xmlNodePtr node) {
   return switchGroup;
 }
 
-static SAudioElementSwitch parseNonInteractiveAudioElementSwitchGroup(xmlNodePtr node) {
+static SAudioElementSwitch parseNonInteractiveAudioElementSwitchGroup(xmlNodePtr node,
+                                                                      SAudioSceneValues& values) {
   SAudioElementSwitch switchGroup{};
 
   if (auto audioElement = findFirstChild(node, "audioElement")) {
     switchGroup.audioElements.push_back(
-        parseAudioElementSwitchItem(audioElement, false /* non-interactive */));
+        parseAudioElementSwitchItem(audioElement, false /* non-interactive */, values));
   } else {
     throw std::invalid_argument{"NonInteractiveAudioElementSwitch has no 'audioElement' property"};
   }
@@ -421,23 +512,23 @@ static SAudioElementSwitch parseNonInteractiveAudioElementSwitchGroup(xmlNodePtr
   return switchGroup;
 }
 
-static SPreset parsePreset(xmlNodePtr node) {
+static SPreset parsePreset(xmlNodePtr node, SAudioSceneValues& values) {
   SPreset preset{};
 
   preset.kind = parseOptionalChild(node, "kind", parsePresetTable);
   preset.customKind = parseOptionalChild(node, "customKind", parseCustomDescriptor);
   parseMandatoryNodeProperty(node, preset.id, "id");
-  parseMandatoryNodeProperty(node, preset.isActive, "isActive");
+  preset.isActiveSlot = parseCurrentValue<bool>(node, "isActive", values);
   parseMandatoryNodeProperty(node, preset.isAvailable, "isAvailable");
   parseMandatoryNodeProperty(node, preset.isDefault, "isDefault");
 
   {
     xmlNodePtr audioElement = nullptr;
     while ((audioElement = findNextChild(node, "audioElement", audioElement))) {
-      preset.audioElements.push_back(parseAudioElement(audioElement));
+      preset.audioElements.push_back(parseAudioElement(audioElement, values));
     }
     while ((audioElement = findNextChild(node, "nonInteractiveAudioElement", audioElement))) {
-      preset.audioElements.push_back(parseAudioElement(audioElement));
+      preset.audioElements.push_back(parseAudioElement(audioElement, values));
     }
   }
 
@@ -447,29 +538,29 @@ static SPreset parsePreset(xmlNodePtr node) {
     while ((audioElementSwitchGroup =
                 findNextChild(node, "nonInteractiveAudioElementSwitch", audioElementSwitchGroup))) {
       preset.switchGroups.push_back(
-          parseNonInteractiveAudioElementSwitchGroup(audioElementSwitchGroup));
+          parseNonInteractiveAudioElementSwitchGroup(audioElementSwitchGroup, values));
     }
 
     while ((audioElementSwitchGroup =
                 findNextChild(node, "audioElementSwitch", audioElementSwitchGroup))) {
-      preset.switchGroups.push_back(parseAudioElementSwitchGroup(audioElementSwitchGroup));
+      preset.switchGroups.push_back(parseAudioElementSwitchGroup(audioElementSwitchGroup, values));
     }
   }
 
   return preset;
 }
 
-static std::vector<SPreset> parsePresets(xmlNodePtr node) {
+static std::vector<SPreset> parsePresets(xmlNodePtr node, SAudioSceneValues& values) {
   std::vector<SPreset> result;
   xmlNodePtr preset = nullptr;
   while ((preset = findNextChild(node, "preset", preset))) {
-    result.push_back(parsePreset(preset));
+    result.push_back(parsePreset(preset, values));
   }
 
   return result;
 }
 
-SAudioSceneConfig parseAudioScene(xmlNodePtr node) {
+SAudioSceneConfig parseAudioScene(xmlNodePtr node, SAudioSceneValues& outValues) {
   SAudioSceneConfig asi{};
 
   if (auto drcInfo = findFirstChild(node, "DRCInfo")) {
@@ -477,13 +568,13 @@ SAudioSceneConfig parseAudioScene(xmlNodePtr node) {
   }
 
   if (auto presets = findFirstChild(node, "presets")) {
-    asi.presets = parsePresets(presets);
+    asi.presets = parsePresets(presets, outValues);
   }
 
   {
     xmlNodePtr audioElement = nullptr;
     while ((audioElement = findNextChild(node, "audioElement", audioElement))) {
-      asi.audioElements.push_back(parseAudioElement(audioElement));
+      asi.audioElements.push_back(parseAudioElement(audioElement, outValues));
     }
   }
 
@@ -491,7 +582,7 @@ SAudioSceneConfig parseAudioScene(xmlNodePtr node) {
     xmlNodePtr audioElementSwitchGroup = nullptr;
     while ((audioElementSwitchGroup =
                 findNextChild(node, "audioElementSwitch", audioElementSwitchGroup))) {
-      asi.switchGroups.push_back(parseAudioElementSwitchGroup(audioElementSwitchGroup));
+      asi.switchGroups.push_back(parseAudioElementSwitchGroup(audioElementSwitchGroup, outValues));
     }
   }
 
@@ -503,8 +594,8 @@ SAudioSceneConfig parseAudioScene(xmlNodePtr node) {
                                 asi.version};
   }
 
-  if (!parseNodeProperty(node, asi.configChanged, "configChange")) {
-    asi.configChanged = false;
+  if (!parseNodeProperty(node, outValues.configChanged, "configChange")) {
+    outValues.configChanged = false;
   }
 
   return asi;